@@ -1,7 +1,9 @@
 //BP.cpp
 #include"BP.h"
 #include"mon_index.h"
+#include"checkpoint.h"
 #include<ios>
+#include<algorithm>
 
 //constructor
 BP_Op::BP_Op(int maxdeg, Z3_Op *Z3_op, matrix<BP> *etaL_mat, matrix<BPBP> *delta_mat, matrix<BP> *R2L_mat) :
@@ -17,6 +19,7 @@ ModuleOp<exponent,Z3>(Z3_op), PolynomialOp_Para<Z3>(Z3_op), BPBP_opers(this), BP
 	Z3_oper = Z3_op;
 	etaL_table = etaL_mat;
 	delta_table = delta_mat;
+	delta_values = NULL;
 	R2L_table = R2L_mat;
 }
 
@@ -50,20 +53,69 @@ void BP_Op::load_delta(string filename){
 	std::cout << "delta data loaded\n" << std::flush;
 }
 
-//the left unit
+//the sum of the coefficients of x times the rows of a table, as a sparse product over the monomials
+//all the products of terms are listed with their exponents, sorted and added up once, instead of adding the partial sums as polynomials
+//with swap, the exponent of a coefficient goes to the outer exponent, as in R2L, otherwise it multiplies the inner coefficients, as in etaL
+BPBP BP_Op::table_maps_to(const vectors<matrix_index,BP> &x, matrix<BP> *table, bool swap){
+	//the rows, and the positions of their products in the list
+	unsigned n = x.size();
+	std::vector<vectors<matrix_index,BP>> rows(n);
+	std::vector<size_t> offset(n+1, 0);
+	for(unsigned k=0; k<n; ++k){
+		rows[k] = table->find(x.dataArray[k].ind);
+		size_t count = 0;
+		for(auto &tm : rows[k].dataArray)
+			count += tm.coeficient.size();
+		offset[k+1] = offset[k] + count * x.dataArray[k].coeficient.size();
+	}
+	
+	//the products, with the outer exponent in the higher 32 bits of the key
+	std::vector<std::pair<uint64_t,Z3>> terms(offset[n]);
+	#pragma omp parallel for schedule(dynamic) if(offset[n] > 4096)
+	for(unsigned k=0; k<n; ++k){
+		size_t pos = offset[k];
+		for(auto &c : x.dataArray[k].coeficient.dataArray)
+			for(auto &tm : rows[k].dataArray)
+				for(auto &b : tm.coeficient.dataArray){
+					uint64_t outer = swap ? c.ind + tm.ind : tm.ind;
+					uint64_t inner = swap ? b.ind : c.ind + b.ind;
+					terms[pos++] = std::make_pair((outer << 32) | inner, Z3_oper->multiply(c.coeficient, b.coeficient));
+				}
+	}
+	std::sort(terms.begin(), terms.end(), [](std::pair<uint64_t,Z3> const &s, std::pair<uint64_t,Z3> const &t){
+		return s.first < t.first; });
+	
+	//add up the products with the same exponents
+	BPBP result;
+	for(size_t i=0; i<terms.size();){
+		uint64_t key = terms[i].first;
+		Z3 sum = terms[i].second;
+		for(++i; i<terms.size() && terms[i].first == key; ++i)
+			sum = Z3_oper->add(sum, terms[i].second);
+		if(Z3_oper->isZero(sum))
+			continue;
+		exponent outer = key >> 32, inner = key & 0xffffffff;
+		if(result.dataArray.empty() || result.dataArray.back().ind != outer)
+			result.push(typename BPBP::term(outer, BP()));
+		result.dataArray.back().coeficient.push(typename BP::term(inner, sum));
+	}
+	return result;
+}
+
+//the left unit, the terms above the maximal degree are dropped
 BPBP BP_Op::etaL(const BP &x){
-	std::function<BPBP(const Z3&, const BPBP&)> scalor_mult = [this] (const Z3 &r, const BPBP &fm){
-		return BPBP_opers.scalor_mult(this->monomial(0,r),fm); };
-	auto xvec = mon_index.poly2vec(x, this);
-	return etaL_table->maps_to(xvec, scalor_mult, &BPBP_opers);
+	vectors<matrix_index,BP> xvec;
+	for(auto &tm : x.dataArray){
+		matrix_index r = mon_index.rank(tm.ind);
+		if(r != monomial_index::invalid_rank)
+			xvec.push(typename vectors<matrix_index,BP>::term(r, this->monomial(0,tm.coeficient)));
+	}
+	return table_maps_to(xvec, etaL_table, false);
 }
 
 //change the left notation to the right notation
 BPBP BP_Op::etaL(const BPBP &x){
-	std::function<BPBP(const BP&, const BPBP&)> scalor_mult = [this](const BP &r, const BPBP &fm){
-		return BPBP_opers.scalor_mult(r,fm); };
-	auto xvec = mon_index.poly2vec(x,&BPBP_opers);
-	return etaL_table->maps_to(xvec,scalor_mult, &BPBP_opers);
+	return table_maps_to(mon_index.poly2vec(x,&BPBP_opers), etaL_table, false);
 }
 
 //the right unit, vn is in the outer
@@ -73,22 +125,83 @@ BPBP BP_Op::etaR(const BP &x){
 	return this->termwise_operation(tfm,x);
 }
 
-//change algebroid to a vector
+//the right unit only moves the exponents of BP to the outer, so A etaR(r) has the terms (a+j, x y) for the terms (j,(b,x)) of A and (a,y) of r
+//the products are listed with the index of the row and the exponents as the key, and added up once
+vectors<matrix_index, BPBP> BP_Op::right_products(std::vector<std::pair<const BPBP*, vectors<matrix_index,BP>>> const &pairs, bool parallel){
+	//the positions of the products in the list
+	unsigned n = pairs.size();
+	std::vector<size_t> offset(n+1, 0);
+	for(unsigned k=0; k<n; ++k){
+		size_t sizeA = 0, sizeV = 0;
+		for(auto &tm : pairs[k].first->dataArray)
+			sizeA += tm.coeficient.size();
+		for(auto &tm : pairs[k].second.dataArray)
+			sizeV += tm.coeficient.size();
+		offset[k+1] = offset[k] + sizeA * sizeV;
+	}
+	
+	//the products, with the outer exponent in the higher 32 bits of the key
+	typedef std::pair<std::pair<matrix_index,uint64_t>,Z3> product;
+	std::vector<product> terms(offset[n]);
+	#pragma omp parallel for schedule(dynamic) if(parallel && offset[n] > 4096)
+	for(unsigned k=0; k<n; ++k){
+		size_t pos = offset[k];
+		for(auto &v : pairs[k].second.dataArray)
+			for(auto &r : v.coeficient.dataArray)
+				for(auto &tm : pairs[k].first->dataArray)
+					for(auto &b : tm.coeficient.dataArray){
+						uint64_t outer = r.ind + tm.ind;
+						terms[pos++] = product(std::make_pair(v.ind, (outer << 32) | b.ind), Z3_oper->multiply(r.coeficient, b.coeficient));
+					}
+	}
+	std::sort(terms.begin(), terms.end(), [](product const &s, product const &t){
+		return s.first < t.first; });
+	
+	//add up the products with the same row and exponents
+	vectors<matrix_index, BPBP> result;
+	for(size_t i=0; i<terms.size();){
+		auto key = terms[i].first;
+		Z3 sum = terms[i].second;
+		for(++i; i<terms.size() && terms[i].first == key; ++i)
+			sum = Z3_oper->add(sum, terms[i].second);
+		if(Z3_oper->isZero(sum))
+			continue;
+		exponent outer = key.second >> 32, inner = key.second & 0xffffffff;
+		if(result.dataArray.empty() || result.dataArray.back().ind != key.first)
+			result.push(typename vectors<matrix_index,BPBP>::term(key.first, BPBP()));
+		BPBP &A = result.dataArray.back().coeficient;
+		if(A.dataArray.empty() || A.dataArray.back().ind != outer)
+			A.push(typename BPBP::term(outer, BP()));
+		A.dataArray.back().coeficient.push(typename BP::term(inner, sum));
+	}
+	return result;
+}
+
+//scalor multiplication using the right unit
+vectors<matrix_index, BPBP> BP_Op::right_scalor_mult(BPBP const &A, vectors<matrix_index, BP> const &V){
+	return right_products({std::make_pair(&A, V)}, false);
+}
+
+//the sum of the coefficients of coa times the rows of M, with the rows converted using the right unit
+vectors<matrix_index, BPBP> BP_Op::right_maps_to(vectors<matrix_index, BPBP> const &coa, matrix<BP> *M, bool parallel){
+	std::vector<std::pair<const BPBP*, vectors<matrix_index,BP>>> pairs;
+	pairs.reserve(coa.size());
+	for(auto &tm : coa.dataArray)
+		pairs.push_back(std::make_pair(&tm.coeficient, M->find(tm.ind)));
+	return right_products(pairs, parallel);
+}
+
+//change algebroid to a vector, the terms above the maximal degree are dropped
 vectors<matrix_index, BP> BP_Op::algebroid2vector(const BPBP& x, int shift){
 	std::function<matrix_index(exponent)> rd = [this,shift](exponent e){
-		return mon_index.mon_index[e]+shift; };
-	return BPBP_opers.re_index(rd,std::move(R2L(x)));
+		matrix_index r = mon_index.rank(e);
+		return r == monomial_index::invalid_rank ? r : r+shift; };
+	return BPBP_opers.filtered_reindex(rd, R2L(x), monomial_index::invalid_rank);
 }
 
 //change right notation to the left notation and switch ti to the outer
 BPBP BP_Op::R2L(const BPBP &x){
-	std::function<BPBP(const BP&, const BPBP&)> scalor_mult = [this](const BP &r, const BPBP &fm){
-		std::function<BP(const Z3&)> tfm = [this](const Z3& r0){
-			return this->monomial(0,r0); };
-		auto r1 = termwise_operation(tfm,r);
-		return BPBP_opers.multiply(r1,fm); };
-	auto xvec = mon_index.poly2vec(x,&BPBP_opers);
-	return R2L_table->maps_to(xvec,scalor_mult, &BPBP_opers);
+	return table_maps_to(mon_index.poly2vec(x,&BPBP_opers), R2L_table, true);
 }
 
 //change back
@@ -111,7 +224,11 @@ void BP_Op::initialize(string etaL_filename, string R2L_filename, string delta_f
 	load_etaL(etaL_filename);
 	load_R2L(R2L_filename);
 	load_delta(delta_filename);
-    
+	init_degrees();
+}
+
+//initialize the degrees of the cofree comodules
+void BP_Op::init_degrees(){
 	//initialize the degree of generators
 	std::function<int(matrix_index)>  cofree_degs = [this](matrix_index n){
 		exponent e = mon_index.mon_array[n];
@@ -122,12 +239,12 @@ void BP_Op::initialize(string etaL_filename, string R2L_filename, string delta_f
 	this->init_cofree_data(cofree_degs);
 }
 
-//make structure tables
-void BP_Op::make_tables(int maxVar, string R2Lfilename, string deltafilename, string etaL_filename, string R2L_filename, string delta_filename, std::ostream &outputfile){
-	//the values on the generators
-	std::vector<BPBP> R2L_gen(maxVar+1);
-	std::vector<BPBPBP> delta_gen(maxVar+1);
-	std::vector<BPBP> etaL_gen(maxVar+1);
+//load the values of the structure maps on the generators
+void BP_Op::load_generators(int maxVar, string R2Lfilename, string deltafilename, std::ostream &outputfile){
+	R2L_gen.resize(maxVar+1);
+	delta_gen.resize(maxVar+1);
+	etaL_gen.resize(maxVar+1);
+	R2L_swapped.resize(maxVar+1);
 	
 	//load the values on the generators. 
 	//for etaR, At this point we use the left unit expression, and the vi are on the outer, ti on the innner
@@ -174,38 +291,124 @@ void BP_Op::make_tables(int maxVar, string R2Lfilename, string deltafilename, st
 	for(int i=1; i<=maxVar; ++i)
 		outputfile << "etaL(v" << i << ") = " << BPBP_opers.output(etaL_gen[i]) << "\n";
 	
+	//for the R2L table, switch vi to the outer
+	std::function<BPBP(BPBP&&,BPBP&&)> merger = [this](BPBP &&x, BPBP &&y){
+		return BPBP_opers.add(std::move(x),std::move(y)); };
+	for(int i=0; i<=maxVar; ++i)
+		R2L_swapped[i] = swapping(R2L_gen[i], merger);
+}
+
+//change delta from left unit notation to right unit notation, as a vector over the monomials
+vectors<matrix_index, BPBP> BP_Op::delta_L2R(const BPBPBP& srf){
+	std::function< std::pair<matrix_index,BPBP>(exponent,const BPBP&)> cf = [this](exponent e, const BPBP &w){
+		return std::make_pair(mon_index.rank_in_index(e),std::move(etaL(w))); };
+	return BPBPBP_opers.termwise_operation(cf,srf);
+}
+
+//write a table to its temporary file, keeping its content if we resume a previous run, and rename it into place when it is complete
+//the lock keeps out the jobs saving the rows they compute on first use, and the tables mapped by them are never changed
+static void write_table(string filename, bool resume, std::function<void(std::iostream&)> writer){
+	string part = checkpoint::temporary(filename);
+	if(resume && !std::fstream(part, std::ios::in).is_open() && std::fstream(filename, std::ios::in).is_open()){
+		std::cout << filename << " is complete\n" << std::flush;
+		return;
+	}
+	//the rows saved by the jobs are dropped when the table is computed from scratch
+	if(!resume){
+		file_lock old(part);
+		if(old.acquire(true))
+			std::remove(part.c_str());
+	}
+	file_lock lk(part);
+	if(!lk.acquire(true, true, true)){
+		std::cerr << "fail to lock " << part << "\n";
+		return;
+	}
+	std::fstream file(part, std::ios::in | std::ios::out | std::ios::binary);
+	writer(file);
+	//drop the end of a row cut off by an interrupted run
+	file.flush();
+	lk.cut(file.tellp());
+	file.close();
+	checkpoint::commit(filename);
+}
+
+//make structure tables
+void BP_Op::make_tables(int maxVar, string R2Lfilename, string deltafilename, string etaL_filename, string R2L_filename, string delta_filename, std::ostream &outputfile, bool resume){
+	load_generators(maxVar, R2Lfilename, deltafilename, outputfile);
+	
 	//compute the etaL table
-	std::function<BPBP(int)> etaL_gens = [&etaL_gen](int i){
+	std::function<BPBP(int)> etaL_gens = [this](int i){
 		return etaL_gen[i]; };
-	std::fstream etaL_tablefile(etaL_filename, std::ios::out | std::ios::binary);
-	mon_index.substitution_table(etaL_gens, etaL_tablefile, &BPBP_opers);
-	etaL_tablefile.close();
+	write_table(etaL_filename, resume, [&](std::iostream &writer){
+		mon_index.substitution_table(etaL_gens, writer, &BPBP_opers, resume); });
 	
 	//compute the R2L table
-	std::function<BPBP(int)> R2L_gens = [&R2L_gen, this](int i){
-		//switch vi to the outer
-		std::function<BPBP(BPBP&&,BPBP&&)> merger = [this](BPBP &&x, BPBP &&y){
-			return BPBP_opers.add(std::move(x),std::move(y)); };
-		return swapping(R2L_gen[i], merger); };
-	std::fstream R2L_tablefile(R2L_filename, std::ios::out | std::ios::binary);
-	mon_index.substitution_table(R2L_gens, R2L_tablefile, &BPBP_opers);
-	R2L_tablefile.close();
+	std::function<BPBP(int)> R2L_gens = [this](int i){
+		return R2L_swapped[i]; };
+	write_table(R2L_filename, resume, [&](std::iostream &writer){
+		mon_index.substitution_table(R2L_gens, writer, &BPBP_opers, resume); });
 	
 	//load the etaL table
 	load_etaL(etaL_filename);
-	//compute the delta table
+	//compute the delta table, the rule is applied in parallel
 	std::function<vectors<matrix_index, BPBP>(const BPBPBP&)> rule = [this](const BPBPBP& srf){
-		//change from left unit notation to right unit notation
-		std::function< std::pair<matrix_index,BPBP>(exponent,const BPBP&)> cf = [this](exponent e, const BPBP &w){
-			return std::make_pair(mon_index.mon_index[e],std::move(etaL(w))); };
-		 return BPBPBP_opers.termwise_operation(cf,srf); };
+		return delta_L2R(srf); };
 	std::function<void(const vectors<matrix_index,BPBP>&, std::iostream&)> outputer = [this](const vectors<matrix_index,BPBP>& x, std::iostream& writer){
 		BPBPMod_opers.save(x, writer); };
-	std::function<BPBPBP(int)> delta_gens = [&delta_gen](int i){
+	std::function<BPBPBP(int)> delta_gens = [this](int i){
 		return delta_gen[i]; };
-	std::fstream delta_tablefile(delta_filename, std::ios::out | std::ios::binary);
-	mon_index.substitution_table(delta_gens, delta_tablefile, &BPBPBP_opers, rule, outputer);
-	delta_tablefile.close();
+	std::function<bool(std::iostream&)> skip = [this](std::iostream& reader){
+		BPBPMod_opers.load(reader);
+		return !reader.fail(); };
+	write_table(delta_filename, resume, [&](std::iostream &writer){
+		mon_index.substitution_table(delta_gens, writer, &BPBPBP_opers, rule, outputer, resume ? skip : nullptr); });
+}
+
+//the rows of the tables on the n-th monomial, as the row of the previous monomial times the value on a variable
+vectors<matrix_index, BP> BP_Op::etaL_row(matrix_index n){
+	auto pr = previous(mon_index.mon_array[n]);
+	if(pr.first == 0)
+		return BPBP_opers.unit(1);
+	return BPBP_opers.multiply(etaL_table->find(mon_index.rank_in_index(pr.second)), etaL_gen[pr.first]);
+}
+
+//the row of the R2L table
+vectors<matrix_index, BP> BP_Op::R2L_row(matrix_index n){
+	auto pr = previous(mon_index.mon_array[n]);
+	if(pr.first == 0)
+		return BPBP_opers.unit(1);
+	return BPBP_opers.multiply(R2L_table->find(mon_index.rank_in_index(pr.second)), R2L_swapped[pr.first]);
+}
+
+//the row of the delta table, from the value of delta in left unit notation
+vectors<matrix_index, BPBP> BP_Op::delta_row(matrix_index n){
+	return delta_L2R(delta_values->find(n));
+}
+
+//initialize with the tables computed on first use, the rows computed are saved to the tables
+void BP_Op::initialize_lazy(int maxVar, string R2Lfilename, string deltafilename, matrix_lazy<BP> *etaL_mat, matrix_lazy<BP> *R2L_mat, matrix_lazy<BPBP> *delta_mat, matrix_lazy<BPBP> *delta_values_mat, std::ostream &outputfile){
+	load_generators(maxVar, R2Lfilename, deltafilename, outputfile);
+	etaL_table = etaL_mat;
+	R2L_table = R2L_mat;
+	delta_table = delta_mat;
+	delta_values = delta_values_mat;
+	
+	unsigned n = mon_index.number_of_all_mons();
+	etaL_mat->set_rule(n, [this](matrix_index i){
+		return etaL_row(i); });
+	R2L_mat->set_rule(n, [this](matrix_index i){
+		return R2L_row(i); });
+	//the values of delta in left unit notation are saved to their own file, as the other tables
+	delta_values->set_rule(n, [this](matrix_index i){
+		auto pr = previous(mon_index.mon_array[i]);
+		if(pr.first == 0)
+			return BPBPBP_opers.unit(1);
+		return BPBPBP_opers.multiply(delta_values->find(mon_index.rank_in_index(pr.second)), delta_gen[pr.first]); });
+	delta_mat->set_rule(n, [this](matrix_index i){
+		return delta_row(i); });
+	
+	init_degrees();
 }
 
 //lift elements in F3 to BP
@@ -239,7 +442,7 @@ BP BP_Op::v1(){
 	
 //return the element h0 = (etaR(v1) - etaL(v1))/p
 BPBP BP_Op::h0(){
-	if(mon_index.max_degree<=1){
+	if(mon_index.max_degree<=1 || total_deg(vars(1)) > mon_index.max_degree){
 		std::cerr << "out of range for h0";
 		return BPBP_opers.zero();
 	}
@@ -252,7 +455,10 @@ BPBP BP_Op::h0(){
 //return the top thetas on the Moore spectrum
 std::vector<BPBP> BP_Op::thetas(){
 	std::vector<BPBP> theta(10);
-	if(mon_index.max_degree<=12){
+	//theta needs the degree above lower, and v2^k inside the index
+	auto out_of_range = [this](int lower, int k){
+		return mon_index.max_degree <= lower || k * total_deg(vars(2)) > mon_index.max_degree; };
+	if(out_of_range(12,1)){
 		std::cerr << "out of range for beta1";
 		return theta;
 	}
@@ -266,7 +472,7 @@ std::vector<BPBP> BP_Op::thetas(){
 	std::cout << "beta1=" << BPBP_opers.output(beta1) << "\n";
 	theta[2] = beta1;
 
-	if(mon_index.max_degree<=28){
+	if(out_of_range(28,2)){
 		std::cerr << "out of range for beta2";
 		return theta;
 	}
@@ -279,7 +485,7 @@ std::vector<BPBP> BP_Op::thetas(){
 	std::cout << "beta2=" << BPBP_opers.output(beta2) << "\n";
 	theta[3] = beta2;
 
-	if(mon_index.max_degree<=36){
+	if(out_of_range(36,3)){
 		std::cerr << "out of range for beta3/3";
 		return theta;
 	}
@@ -293,7 +499,7 @@ std::vector<BPBP> BP_Op::thetas(){
 	theta[4] = beta33;
 
 
-	if(mon_index.max_degree<=60){
+	if(out_of_range(60,4)){
 		std::cerr << "out of range for beta4";
 		return theta;
 	}
@@ -307,7 +513,7 @@ std::vector<BPBP> BP_Op::thetas(){
 	theta[5] = beta4;
 
 
-	if(mon_index.max_degree<=76){
+	if(out_of_range(76,5)){
 		std::cerr << "out of range for beta5";
 		return theta;
 	}
@@ -320,7 +526,7 @@ std::vector<BPBP> BP_Op::thetas(){
 	std::cout << "beta5=" << BPBP_opers.output(beta5) << "\n";
 	theta[6] = beta5;
 
-	if(mon_index.max_degree<=84){
+	if(out_of_range(84,6)){
 		std::cerr << "out of range for beta6/3";
 		return theta;
 	}
@@ -371,12 +577,12 @@ BPBP BP_Op::divide_v1(const BPBP& x,int n){
 			x1.push({tm.ind,a1});
 	}
 	
-	//divide by v1^n
+	//divide by v1^n, which subtracts a constant from the packed exponents and keeps their order
 	std::function<exponent(exponent)> rl = [this,n](exponent e) { 
 		auto nt = unpack(e);
 		if(nt[0]<n) std::cerr << "not v1-divisible";
 		nt[0] -= n;
 		return pack(nt.data());
 	};
-	return BPBP_opers.re_index(rl,x1);
+	return BPBP_opers.re_index_monotone(rl,std::move(x1));
 }
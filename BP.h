@@ -3,6 +3,7 @@
 #include"Z3.h"
 #include"polynomial.h"
 #include"matrices.h"
+#include"matrices_lazy.h"
 #include"mon_index.h"
 #include"hopf_algebroid.h"
 #include"BPQ.h"
@@ -54,6 +55,17 @@ private:
 	
 	//table for change from right to left and switch the place of vi and ti
 	matrix<BP> *R2L_table;
+	
+	//the values of the structure maps on the generators
+	std::vector<BPBP> R2L_gen, etaL_gen;
+	std::vector<BPBPBP> delta_gen;
+	//the values for R2L, with vi switched to the outer
+	std::vector<BPBP> R2L_swapped;
+	//the values of delta in left unit notation, for the lazy delta table
+	matrix_lazy<BPBP> *delta_values;
+	
+	//initialize the degrees of the cofree comodules
+	void init_degrees();
         
 public:
 	BP_Op(int maxdeg, Z3_Op*, matrix<BP> *etaL_mat, matrix<BPBP> *delta_mat, matrix<BP> *R2L_mat);
@@ -63,6 +75,9 @@ public:
 	void load_R2L(string);
 	void load_delta(string);
 
+	//the sum of the coefficients of x times the rows of a table, with the exponents of the coefficients moved to the outer if swap is set
+	BPBP table_maps_to(const vectors<matrix_index,BP> &x, matrix<BP> *table, bool swap);
+	
 	//left unit
 	BPBP etaL(const BP&);
 	
@@ -71,6 +86,15 @@ public:
         
 	//right unit
 	BPBP etaR(const BP&);
+	
+	//the sums of the products A etaR(V) for the pairs (A,V), added up at once without forming etaR
+	vectors<matrix_index, BPBP> right_products(std::vector<std::pair<const BPBP*, vectors<matrix_index,BP>>> const &pairs, bool parallel);
+	
+	//scalor multiplication using the right unit
+	vectors<matrix_index, BPBP> right_scalor_mult(BPBP const &A, vectors<matrix_index, BP> const &V);
+	
+	//the sum of the coefficients of coa times the rows of M, with the rows converted using the right unit
+	vectors<matrix_index, BPBP> right_maps_to(vectors<matrix_index, BPBP> const &coa, matrix<BP> *M, bool parallel);
         
 	//change the notation from right to left
 	BPBP R2L(const BPBP&);
@@ -98,6 +122,14 @@ public:
         
 	//initilaizaiotn
 	void initialize(string etaL_filename, string R2L_filename, string delta_filename);
+	
+	//initialize with the tables computed on first use from the values on the generators, and saved to the files of the tables
+	void initialize_lazy(int maxVar, string R2Lfilename, string deltafilename, matrix_lazy<BP> *etaL_mat, matrix_lazy<BP> *R2L_mat, matrix_lazy<BPBP> *delta_mat, matrix_lazy<BPBP> *delta_values_mat, std::ostream &outputfile);
+	
+	//the rows of the tables on a monomial
+	vectors<matrix_index, BP> etaL_row(matrix_index);
+	vectors<matrix_index, BP> R2L_row(matrix_index);
+	vectors<matrix_index, BPBP> delta_row(matrix_index);
         
 	//lift elements in F3 to BP_*
 	BP lift(F3);
@@ -105,8 +137,14 @@ public:
 	//lift vectors over F3 to vectors over BP_*
 	vectors<matrix_index,BP> lift(const vectors<matrix_index,F3>&);
 	
+	//load the values of the structure maps on the generators
+	void load_generators(int maxVar, string R2Lfilename, string deltafilename, std::ostream &outputfile);
+	
+	//change delta from left unit notation to right unit notation
+	vectors<matrix_index, BPBP> delta_L2R(const BPBPBP&);
+	
 	//make the structure tables
-	void make_tables(int maxVar, string R2Lfilename, string deltafilename, string etaL_filename, string R2L_filename, string delta_filename, std::ostream &outputfile=std::cout);
+	void make_tables(int maxVar, string R2Lfilename, string deltafilename, string etaL_filename, string R2L_filename, string delta_filename, std::ostream &outputfile=std::cout, bool resume=false);
 	
 	//return the element h0
 	BPBP h0();
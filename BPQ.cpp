@@ -1,5 +1,6 @@
 //BPQ.cpp
 #include "BPQ.h"
+#include<fstream>
 
 BPQ_Op::BPQ_Op(Qp_Op *Qpoper, Qp_int *Qpintop, int Mvar) : ModuleOp<exponent, Qp>::ModuleOp(Qpoper), PolynomialOp_Para<Qp>(Qpoper), BPBPQ_oper(this), BPBPBPQ_oper(&BPBPQ_oper), BPint_oper(Qpintop), BPBPint_oper(&BPint_oper), BPBPBPint_oper(&BPBPint_oper){
 	maxVar = Mvar;
@@ -261,3 +262,30 @@ void BPQ_Op::output_delta(std::iostream &writer){
 		BPBPBPint_oper.save(y, writer);
 	}
 }
+
+//compute the structure data on the generators for p=3, and save them to the files filename + "structures", "R2L_gen" and "delta_gen"
+void make_generator_data(int max_var, string filename){
+	//construct rational operators
+	Q3_int Q3intoper;
+	Q3_Op Q3_oper;
+	BPQ_Op BPQ_oper(&Q3_oper,&Q3intoper,max_var);
+	
+	//output the structure data
+	std::fstream data_gens(filename + "structures", std::ios::out);
+	data_gens << BPQ_oper.show_li();
+	data_gens << BPQ_oper.show_vn();
+	data_gens << BPQ_oper.show_etaR();
+	data_gens.close();
+	
+	//construct the binary structure tables
+	std::fstream R2Lfile(filename + "R2L_gen", std::ios::out | std::ios::binary);
+	std::fstream deltafile(filename + "delta_gen", std::ios::out | std::ios::binary);
+	BPQ_oper.output_R2L(R2Lfile);
+	BPQ_oper.output_delta(deltafile);
+	R2Lfile.close();
+	deltafile.close();
+#ifndef QP_GMP
+	//the terms cancelled out in the rational computations are known modulo this power of 3
+	std::cout << "cancelled terms are zero modulo 3^" << Q3_oper.cancelled_precision() << "\n" << std::flush;
+#endif
+}
@@ -96,3 +96,6 @@ public:
 	void output_R2L(std::iostream &writer);
 	void output_delta(std::iostream &writer);
 };
+
+//compute the structure data on the generators for p=3, and save them to the files filename + "structures", "R2L_gen" and "delta_gen"
+void make_generator_data(int max_var, string filename);
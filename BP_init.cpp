@@ -6,18 +6,23 @@ BPComodInit::BPComodInit(string filename) : BPCoMod_generic(&coaction_matrix), c
 }
 
 //the constructor
-BPInit::BPInit(int max_deg, int res_length, string etaL_data, string delta_data, string R2L_data, string dirname) : BP_oper(max_deg, &Z3_oper, &etaL_matrix, &delta_matrix, &R2L_matrix), F3Mod_opers(&Z3_oper.F3_opers), etaL_matrix(dirname + "etaL_matrix"), R2L_matrix(dirname + "R2L_matrix"), delta_matrix(dirname + "delta_matrix"), indj(dirname + "indj"), qut(dirname + "qut"), new_map(dirname + "new_map"), mm(dirname + "mm_matrix"), comod(dirname + "comodule_matrix"), multp(&BP_oper){
+BPInit::BPInit(int max_deg, int res_length, string data, string dirname) : progress(dirname + "manifest"), BP_oper(max_deg, &Z3_oper, &etaL_matrix, &delta_matrix, &R2L_matrix), F3Mod_opers(&Z3_oper.F3_opers), etaL_matrix(data + "etaL"), R2L_matrix(data + "R2L"), delta_matrix(data + "delta"), delta_values(data + "delta_values"), indj(dirname + "indj"), qut(dirname + "qut"), new_map(dirname + "new_map"), mm(dirname + "mm_matrix"), comod(dirname + "comodule_matrix"), multp(&BP_oper){
 	max_degree = max_deg;
 	resolution_length = res_length;
 	director = dirname;
+	redo = false;
 	
 	//initialize matric operators
 	matrix<BP>::moduleOper = &BP_oper.BPMod_opers;
 	matrix<BPBP>::moduleOper = &BP_oper.BPBPMod_opers;
 	matrix<Z3>::moduleOper = &BP_oper.Z3Mod_opers;
 
-	//initialize the structure data
-	BP_oper.initialize(etaL_data, delta_data, R2L_data);
+	//initialize the structure data, the values on the generators are computed if BPtab has not been run
+	int max_var = BP_oper.mon_index.max_var;
+	if(!std::fstream(data + "R2L_gen", std::ios::in).is_open() || !std::fstream(data + "delta_gen", std::ios::in).is_open())
+		make_generator_data(max_var, data);
+	std::fstream Ls(dirname + "Ls", std::ios::out);
+	BP_oper.initialize_lazy(max_var, data + "R2L_gen", data + "delta_gen", &etaL_matrix, &R2L_matrix, &delta_matrix, &delta_values, Ls);
 	
 	//initialize the comod to a trivial one with one generator at degree 0
 	BP_oper.set_to_trivial(comod,0);
@@ -28,6 +33,9 @@ BPInit::BPInit(int max_deg, int res_length, string etaL_data, string delta_data,
 	
 	//set the complex of primitives
 	primitive_data::set_oper(&BP_oper);
+	mapses.resize(resolution_length + 2);
+	Complex.set_maps(resolution_length, [this](int i){
+		return &mapses[i]; });
 	
 	//set the algebraic Novikov table
 	algNov_table::set_op(&BP_oper);
@@ -39,15 +47,55 @@ BPInit::BPInit(int max_deg, int res_length, string etaL_data, string delta_data,
 	Btables.set_table(&B_table);
 }
 
+//the stages after the resolution, in the order they are run
+static const std::vector<string> BP_stages = {"resolution", "AANSS", "BocSS", "products", "massey"};
+
+//tell if a stage can be skipped
+bool BPInit::skip(string stage){
+	if(!redo && progress.completed(stage)){
+		std::cout << stage << " is already done\n" << std::flush;
+		return true;
+	}
+	redo = true;
+	progress.reset(stage);
+	return false;
+}
+
+//record a stage
+void BPInit::done(string stage, std::vector<string> const &files){
+	for(auto &f : files)
+		checkpoint::commit(f);
+	progress.complete(stage, -1, files);
+}
+
 //do resolutions
-void BPInit::resolve(){
+void BPInit::resolve(int res_start){
+	if(res_start<0)
+		res_start = progress.resume("resolve");
+	//the later stages are out of date once the resolution is changed
+	if(res_start!=resolution_length){
+		redo = true;
+		for(auto &st : BP_stages)
+			progress.reset(st);
+	}
+	
+	//record the files of each step
+	std::function<void(int)> step_done = [this](int i){
+		std::vector<string> files = {director + "maps" + std::to_string(i), director + "gens" + std::to_string(i)};
+		if(i==0){
+			progress.reset("resolve");
+			files.push_back(director + "gens");
+		}
+		progress.complete("resolve", i, files); };
+	
+
 	std::function<curtis_table<F3>*(int)> tables = [this](int i){
 		return &ResolutionTables[i]; };
 	
 	std::function<vectors<matrix_index,BP>(const vectors<matrix_index,Fp>&)> tfm = [this] (const vectors<matrix_index,Fp>& v){ 
 		return BP_oper.lift(v); };
 		
-	BP_oper.pre_resolution_modeled(comod, director + "maps", director + "gens", resolution_length, director+"tables", &ctable, gens, tfm, &inj, &qut, &indj, &new_map, director + "back");
+	BP_oper.pre_resolution_modeled(comod, director + "maps", director + "gens", resolution_length, director+"tables", &ctable, gens, tfm, &inj, &qut, &indj, &new_map, director + "back", res_start, step_done);
 	
 	//combining generator files
 	BP_oper.gens_file_combiner(director + "gens", resolution_length, comod);
@@ -55,17 +103,21 @@ void BPInit::resolve(){
 
 //construct resolution
 void BPInit::resolution(){
+	if(skip("resolution"))
+		return;
+	string res = director + "res", cpx = director + "cpx";
+	
 	//construct the resolution
 	std::fstream outfile("maps.txt", std::ios::out);
-	BP_oper.resolution(director + "maps", director + "gens", director + "res" , resolution_length, comod, &inj, &qut, &indj, NULL);
+	BP_oper.resolution(director + "maps", director + "gens", checkpoint::temporary(res) , resolution_length, comod, &inj, &qut, &indj, NULL);
 	
 	//set the matrices
-	mapses.resize(resolution_length + 2);
 	std::function <matrix<Z3>*(int)> mst = [this](int i){
 		return &mapses[i]; };
 	//construct the complex of primitives
-	Complex.load(resolution_length,director + "gens",director + "res",&inj,&indj,mst);
-	Complex.save_matrix(director + "cpx");
+	Complex.load(resolution_length,director + "gens",checkpoint::temporary(res),mst);
+	Complex.save_matrix(checkpoint::temporary(cpx));
+	done("resolution", {res, cpx});
 }
 
 //load the curtis table data
@@ -97,37 +149,56 @@ void BPInit::load_gens(string gens_data){
 //make algebraic Novikov table
 void BPInit::make_algNov(){
 	Complex.load_matrix(resolution_length,director + "gens", director+"cpx");
+	string bin = director + "AANSS_table_binary", txt = director + "AANSS_table.txt", a0 = director + "AANSS_a0.txt";
+	//the Bockstein tables are named after the algebraic Novikov tables
+	if(skip("AANSS")){
+		AANtables.load(bin);
+		AANtables.set_complex(Complex);
+		return;
+	}
 	
 	AANtables.table_of_complex(Complex,resolution_length);
-	AANtables.save(director + "AANSS_table_binary");
-	std::fstream atb(director + "AANSS_table.txt", std::ios::out);
+	AANtables.save(checkpoint::temporary(bin));
+	std::fstream atb(checkpoint::temporary(txt), std::ios::out);
 	atb << AANtables.output_tables();
+	atb.close();
 	
 	auto et2 = multp.three_extension(resolution_length,Complex,AANtables,resolution_length);
-	std::fstream a0f(director + "AANSS_a0.txt", std::ios::out);
+	std::fstream a0f(checkpoint::temporary(a0), std::ios::out);
 	a0f << multp.output_multiplication_table(et2,0,resolution_length-1);
+	a0f.close();
+	done("AANSS", {bin, txt, a0});
 }
 
 //make Bockstein table
 void BPInit::make_Boc(){
+	if(skip("BocSS"))
+		return;
+	string bin = director + "BocSS_table_binary", txt = director + "BocSS_table.txt", b2a_name = director + "B2A_table.txt", a0 = director + "BocSS_a0.txt";
 	Complex.load_matrix(resolution_length,director + "gens", director+"cpx");
 	
 	Btables.table_of_complex(Complex,resolution_length);
-	Btables.save(director + "BocSS_table_binary");
-	std::fstream btb(director + "BocSS_table.txt", std::ios::out);
+	Btables.save(checkpoint::temporary(bin));
+	std::fstream btb(checkpoint::temporary(txt), std::ios::out);
 	btb << Btables.output_tables();
+	btb.close();
 	
 	auto ba = Btables.Bname2Anames(resolution_length, AANtables, resolution_length);
-	std::fstream b2a(director + "B2A_table.txt", std::ios::out);
+	std::fstream b2a(checkpoint::temporary(b2a_name), std::ios::out);
 	b2a << multp.output_multiplication_table(ba,0,resolution_length-1);
+	b2a.close();
 	
 	auto et2 = multp.three_extension(resolution_length,Complex,Btables,resolution_length);
-	std::fstream a0f(director + "BocSS_a0.txt", std::ios::out);
+	std::fstream a0f(checkpoint::temporary(a0), std::ios::out);
 	a0f << multp.output_multiplication_table1(et2,0,resolution_length-1);
+	a0f.close();
+	done("BocSS", {bin, txt, b2a_name, a0});
 }
 
-//make the algebraic Novikov multiplication table by a given element in BPBP
-void BPInit::mult_table(BPBP const &mul, int deg, string filename){
+//make the tables of h0 and the top thetas in one pass over the resolution
+void BPInit::mult_tables(){
+	if(skip("products"))
+		return;
 	//load the complex
 	auto genst = BPComplex::get_generator(resolution_length, director + "gens");
 	//load the complex of primitives
@@ -135,53 +206,48 @@ void BPInit::mult_table(BPBP const &mul, int deg, string filename){
 	//load the algebraic Novikov table
 	AANtables.load(director + "AANSS_table_binary");
 	Btables.load(director + "BocSS_table_binary");
-	//make the multiplication table on BPBP
-	multp.make_eta_R_multiplier(mul, &inj, deg);
-	//compute the table for the multiplication on algebraic Novikov spectral sequence
-	auto multable = multp.mult_extension(&inj, max_degree-deg, resolution_length, genst, director + "res", Complex, AANtables, &indj, &mm, resolution_length);
-	//output the table
-	std::fstream file(director + "AANSS_" + filename, std::ios::out);
-	file << multp.output_multiplication_table(multable, 1, resolution_length-2);
-	//compute the table for the multiplication on Bockstein spectral sequence
-	auto Bmultable = multp.mult_extension1(&inj, max_degree-deg, resolution_length, genst, director + "res", Complex, Btables, &indj, &mm, 1, true);
-	//output the table
-	std::fstream fileB(director + "BocSS_" + filename, std::ios::out);
-	fileB << multp.output_multiplication_table(Bmultable, 1, resolution_length-2);
+	
+	//h0 is the first multiplier, followed by the top thetas
+	auto theta = BP_oper.thetas();
+	int deg[maxVar+1] = {12,28,36,60,76,84};
+	std::vector<std::pair<BPBP,int>> multipliers = {std::make_pair(BP_oper.h0(), 4)};
+	std::vector<product_request> requests = {{0, &AANtables, resolution_length, false, false, {}}, {0, &Btables, 1, true, true, {}}};
+	for(int i=2; i<=7; ++i){
+		multipliers.push_back(std::make_pair(theta[i], deg[i-2]));
+		requests.push_back({i-1, &Btables, 1, true, false, {}});
+	}
+	multp.mult_extensions(multipliers, requests, max_degree, resolution_length, genst, director + "res", Complex, &indj, &mm);
+	
+	//output the tables
+	std::vector<string> files = {director + "AANSS_h0.txt", director + "BocSS_h0.txt"};
+	for(int i=2; i<=7; ++i)
+		files.push_back(director + "BocSS_theta" + std::to_string(i) + ".txt");
+	for(unsigned k=0; k<requests.size(); ++k){
+		std::fstream file(checkpoint::temporary(files[k]), std::ios::out);
+		file << multp.output_multiplication_table(requests[k].result, 1, k<2 ? resolution_length-2 : resolution_length+1);
+		file.close();
+	}
+	done("products", files);
 }
 
-//make multiplication table for top theta on the Moore spectrum
-void BPInit::mult_theta(int resolution_length){
+//make the table of the Massey products <c,3,h0> on the algebraic Novikov spectral sequence
+void BPInit::massey_table(){
+	if(skip("massey"))
+		return;
 	//load the complex
 	auto genst = BPComplex::get_generator(resolution_length, director + "gens");
 	//load the complex of primitives
 	Complex.load_matrix(resolution_length, director +"gens", director + "cpx");
-
 	//load the algebraic Novikov table
 	AANtables.load(director + "AANSS_table_binary");
-	Btables.load(director + "BocSS_table_binary");
-	
-	//compute the top thetas
-	auto theta = BP_oper.thetas();
-	
-	//degree of theta
-	int deg[maxVar+1] = {12,28,36,60,76,84};
-	for(int i=2; i<=7; ++i){
-		//make the multiplication table on BPBP
-		multp.make_eta_R_multiplier(theta[i], &inj, deg[i-2]);
-		//compute the table for the multiplication on Bockstein spectral sequence
-		auto Bmultable = multp.mult_extension(&inj, max_degree-deg[i-2], resolution_length, genst, director + "res", Complex, Btables, &indj, &mm, 1, true);
-		//output the table
-		std::fstream fileB(director + "BocSS_theta" + std::to_string(i) + ".txt", std::ios::out);
-		fileB << multp.output_multiplication_table(Bmultable, 1, resolution_length+1); // EB: the last argument here is 1 + the last homological degree where theta products are recorded in the output files ...theta2.txt, etc.
-	}
-}
-
-//make the algebraic Novikov multiplication table by a given element in BPBP
-void BPInit::mult_table(){
-	//make the h0 multiplication table
-	BPBP h0 = BP_oper.h0();
-	// h0 is defined as (eta_R(v1) - eta_L(v1))/p
-	BPBP h02 = BP_oper.BPBP_opers.multiply(h0, h0);
-	mult_table(h0, 4, "h0.txt");
-//	mult_table(h02, 8, "h0squared.txt");
+	AANtables.set_complex(Complex);
+	
+	//3h0 = etaR(v1)-etaL(v1)
+	massey mas(&BP_oper, &multp, BP_oper.h0(), BP_oper.v1(), 4, "h0");
+	auto brackets = mas.brackets({}, max_degree, resolution_length, genst, director + "res", Complex, AANtables, &indj, &mm, resolution_length);
+	string filename = director + "AANSS_massey_h0.txt";
+	std::fstream file(checkpoint::temporary(filename), std::ios::out);
+	file << mas.output(brackets, resolution_length);
+	file.close();
+	done("massey", {filename});
 }
@@ -5,7 +5,9 @@
 #include"matrices_stream.h"
 #include"algNov.h"
 #include"multiplication.h"
+#include"massey.h"
 #include"Boc.h"
+#include"checkpoint.h"
 
 //initialize a generic comodule
 class BPComodInit : public BPCoMod_generic{
@@ -27,6 +29,15 @@ public:
 	//the director for the data
 	string director;
 	
+	//the manifest of the completed stages
+	checkpoint progress;
+	//set once a stage is recomputed, so that the later stages are recomputed as well
+	bool redo;
+	//tell if a stage can be skipped, otherwise forget its record
+	bool skip(string stage);
+	//move the outputs of a stage to their places and record it
+	void done(string stage, std::vector<string> const &files);
+	
 	//the operations on Z3
 	Z3_Op Z3_oper;
 	//the operations on BP
@@ -34,9 +45,9 @@ public:
 	//operations on F3-modules
 	ModuleOp<matrix_index,F3> F3Mod_opers;
 	
-	//the matrices for the structure data
-	matrix_file<BP> etaL_matrix, R2L_matrix;
-	matrix_file<BPBP> delta_matrix;
+	//the matrices for the structure data, computed on first use and saved to the tables of BPtab
+	matrix_lazy<BP> etaL_matrix, R2L_matrix;
+	matrix_lazy<BPBP> delta_matrix, delta_values;
 	
 	//the complex of primitives
 	BPComplex Complex;
@@ -74,10 +85,11 @@ public:
 	void load_gens(string gens_data);
 	
 	//the constructor
-	BPInit(int max_deg, int resolution_length, string etaL_data, string delta_data, string R2L_data, string dirname);
+	//the structure data are read from the files of BPtab with the prefix data, and the missing parts are computed
+	BPInit(int max_deg, int resolution_length, string data, string dirname);
 	
-	//do resolutions
-	void resolve();
+	//do resolutions, extending a previous run of length res_start if res_start>=0, otherwise resuming from the manifest
+	void resolve(int res_start = -1);
 	
 	//construct resolution
 	void resolution();
@@ -87,9 +99,8 @@ public:
 	//make Bockstein table
 	void make_Boc();
 	
-	//make multiplication table
-	void mult_table(BPBP const &, int, string);
-	void mult_table();
-	//make multiplication table for top theta on the Moore spectrum
-	void mult_theta(int);
+	//make the tables of h0 and the top thetas in one pass over the resolution
+	void mult_tables();
+	//make the table of the Massey products <c,3,h0> on the algebraic Novikov spectral sequence
+	void massey_table();
 };
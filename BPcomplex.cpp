@@ -1,5 +1,6 @@
 //BPcomplex.cpp
 #include"BPcomplex.h"
+#include"matrices_mem.h"
 
 //BP operations
 BP_Op *primitive_data::BPoper;
@@ -12,6 +13,14 @@ void primitive_data::set_oper(BP_Op* BPop){
 	Z3Mod_oper = &BPop->Z3Mod_opers;
 }
 
+//the image of a primitive, which is etaR(v^e)[shift] mapped by X
+vectors<matrix_index,Z3> BPComplex::prim_map_row(const primitive_data& source, const primitive_data& target, matrix<BP>* X, int i){
+	auto v = primitive_data::BPoper->monomial(source[i].coeficient);
+	auto v1 = primitive_data::BPoper->etaR(v);
+	auto w = primitive_data::BPoper->algebroid2vector(v1,source.gen_shift[i]);
+	return target.expand(X->maps_to(w));
+}
+
 //compute the complex on primitives, the formula being etaR(v^e)[shift]
 void BPComplex::make_prim_map(const primitive_data& source, const primitive_data& target, matrix<BP>* X, matrix<BP> *result, matrix<Z3> *map){
 	std::function<vectors<matrix_index,BP>(int)> rows = [&source,X](int i){
@@ -34,11 +43,14 @@ void BPComplex::make_prim_map(const primitive_data& source, const primitive_data
 
 //add a new entry for the primitives
 void primitive_data::add(prim_entry itm, int shift, int deg){
-	auto k = size();
-	prim_index.emplace(itm, k);
+	//the first entry of a new generator
+	if(itm.gen_pos >= gen_base.size())
+		gen_base.resize(itm.gen_pos+1, size());
 	push_back(itm);
 	gen_shift.push_back(shift);
 	gen_deg.push_back(deg);
+	num_v.push_back(total_deg(itm.coeficient, [](int){return 1;}));
+	lex.push_back(lex_pack(itm.coeficient));
 }
 
 //make the primitive data using the list of monimials
@@ -74,18 +86,25 @@ bool prim_entry::operator<(const prim_entry y) const{
 //expand a verctor over BP into a vector over Zp
 vectors<matrix_index, Z3> primitive_data::expand(const vectors<matrix_index,BP>& v) const{
 	vectors<matrix_index, Z3> result;
-
+	
+	unsigned n = 0;
+	for(auto &tm : v.dataArray)
+		n += tm.coeficient.size();
+	result.dataArray.reserve(n);
+	
 	for(unsigned i=0; i<v.size(); ++i)
 		for(unsigned j=0; j<v.dataArray[i].coeficient.size(); ++j){
+			//the zero coefficients kept in the tables are dropped
+			auto &c = v.dataArray[i].coeficient.dataArray[j].coeficient;
+			if(BPoper->Z3_oper->isZero(c))
+				continue;
 			//the corresponding element is v^(e)[g], set ns={g,e}
 			prim_entry ns = {v.dataArray[i].ind,v.dataArray[i].coeficient.dataArray[j].ind};
 			
-			//find the place of this entry
-			auto n = prim_index.at(ns);
-			
-			//add this new term to result
-			result = Z3Mod_oper->add(result, Z3Mod_oper->singleton(n,v.dataArray[i].coeficient.dataArray[j].coeficient));
+			//the entries are distinct, so the terms can be put in the back and sorted at the end
+			result.push(vectors<matrix_index, Z3>::term(find(ns),c));
 		}
+	result.sort();
 	return result;
 }
 
@@ -98,8 +117,8 @@ string prim_entry::output() const {
 //output the primitives
 string primitive_data::output(){
 	string res;
-	for(auto sf : *this)
-		res += std::to_string(prim_index[sf]) + ":" + sf.output() + "\n";
+	for(unsigned i=0; i<size(); ++i)
+		res += std::to_string(i) + ":" + at(i).output() + "\n";
 	return res;
 }
 
@@ -117,35 +136,54 @@ std::vector<int> BPComplex::load_prim(int resolution_length, std::fstream &gens_
 	return F_rank;
 }
 
+//set the containers of the maps
+void BPComplex::set_maps(int resolution_length, std::function<matrix<Z3>*(int)> map_constr){
+	Maps.resize(resolution_length+1);
+	for(int i=0;i<=resolution_length;++i){
+		Maps[i] = map_constr(i);
+		Maps[i]->clear();
+	}
+}
+
 //comstruct a complex from a resolution by taking the primitives
-void BPComplex::load(int resolution_length, string generator_filename, string maps_filename, matrix<BP>* mp, matrix<BP>* pm, std::function<matrix<Z3>*(int)> map_constr){
+void BPComplex::load(int resolution_length, string generator_filename, string maps_filename, std::function<matrix<Z3>*(int)> map_constr, unsigned window){
 	//open the files for the generators and maps of a resolution
 	std::fstream gens_file(generator_filename, std::ios::in | std::ios::binary);
 	std::fstream maps_file(maps_filename, std::ios::in | std::ios::binary);
 	
 	//intialize the containers
 	Prims.resize(resolution_length+1);
-	Maps.resize(resolution_length+1);
-	
-	//initialize the maps
-	for(int i=0;i<=resolution_length;++i){
-		Maps[i] = map_constr(i);
-		Maps[i]->clear();
-	}
+	set_maps(resolution_length, map_constr);
 		
 	std::cout << "constructing primitve data...\n" << std::flush;
 	
 	//load the data of the generators
 	auto F_rank = load_prim(resolution_length,gens_file);
 	
+	//the matrices of the resolution in a window
+	std::vector<matrix_mem<BP>> mps(window);
+	
 	//construct the maps
-	for(int i=1;i<=resolution_length; ++i){
-		std::cout << i << " " << std::flush;
-		//load the matrix in the resolution
-		mp->load(maps_file);
+	for(int i0=1; i0<=resolution_length; i0+=window){
+		int i1 = std::min(i0+(int)window-1, resolution_length);
 		
-		//construct the map of primitives
-		make_prim_map(Prims[i-1],Prims[i],mp,pm,Maps[i]);
+		//load the matrices in the resolution, and list the rows of the maps of primitives
+		std::vector<std::pair<int,int>> rows;
+		for(int i=i0; i<=i1; ++i){
+			std::cout << i << " " << std::flush;
+			mps[i-i0].clear();
+			mps[i-i0].load(maps_file);
+			Maps[i]->set_rank(Prims[i-1].size());
+			for(unsigned k=0; k<Prims[i-1].size(); ++k)
+				rows.push_back(std::make_pair(i,k));
+		}
+		
+		//construct the maps of primitives, the rows of all the degrees in the window being independent
+		#pragma omp parallel for schedule(dynamic)
+		for(unsigned n=0; n<rows.size(); ++n){
+			int i = rows[n].first;
+			Maps[i]->insert(rows[n].second, prim_map_row(Prims[i-1],Prims[i],&mps[i-i0],rows[n].second));
+		}
 	}
 }
 
@@ -24,12 +24,15 @@ public:
 	static BP_Op *BPoper;
 	//Zp module operations
 	static ModuleOp<matrix_index,Z3> *Z3Mod_oper;
-	//index for searching
-	std::map<prim_entry,unsigned> prim_index;
+	//the place of the first entry of each generator, the entries of a generator being ordered as the monomials
+	std::vector<unsigned> gen_base;
 	//the shift of the generators, i.e. the place of the primitives in the whole complex
 	std::vector<matrix_index> gen_shift;
 	//degree of generators
 	std::vector<int> gen_deg;
+	//the number of v's and the lexicographic packing of the exponent of each entry, for naming the terms
+	std::vector<int> num_v;
+	std::vector<uint32_t> lex;
 	
 	//set the operators, remember to run this before doing anything
 	static void set_oper(BP_Op*);
@@ -37,6 +40,18 @@ public:
 	//add a new entry
 	void add(prim_entry,int,int);
 	
+	//the place of an entry, the entries of a generator end at the first entry of the next one
+	inline unsigned find(prim_entry const &itm) const{
+		matrix_index r = BPoper->mon_index.rank(itm.coeficient);
+		if(itm.gen_pos < gen_base.size()){
+			unsigned end = itm.gen_pos+1 < gen_base.size() ? gen_base[itm.gen_pos+1] : size();
+			if(r < end - gen_base[itm.gen_pos])
+				return gen_base[itm.gen_pos] + r;
+		}
+		std::cerr << "the entry " << itm.output() << " is not in the primitives of " << gen_base.size() << " generators\n";
+		abort();
+	}
+	
 	//make the primitive data using the list of monimials
 	static primitive_data make_primitives(int degree, int pos, int, monomial_index*);
 	
@@ -58,8 +73,11 @@ public:
 	std::vector<primitive_data> Prims;
 	std::vector<matrix<Z3>*> Maps;
 	
-	//construct the complex of primitives from a resolution
-	void load(int resolution_length, string generator_filename, string maps_filename, matrix<BP>*, matrix<BP>*, std::function<matrix<Z3>*(int)>);
+	//set the containers of the maps
+	void set_maps(int resolution_length, std::function<matrix<Z3>*(int)>);
+	
+	//construct the complex of primitives from a resolution, the maps of window homological degrees are constructed at a time in parallel
+	void load(int resolution_length, string generator_filename, string maps_filename, std::function<matrix<Z3>*(int)>, unsigned window = 4);
 	
 	//IO operations
 	void save_matrix(string);
@@ -71,6 +89,8 @@ public:
 	
 	//construct the map of primitives, using the data source ->^{X} target
 	static void make_prim_map(const primitive_data& source, const primitive_data& target, matrix<BP>* X, matrix<BP> *, matrix<Z3> *);
+	//the image of the i-th primitive of source
+	static vectors<matrix_index,Z3> prim_map_row(const primitive_data& source, const primitive_data& target, matrix<BP>* X, int i);
 	
 	//get the data for the generators
 	static std::vector<FreeBPCoMod> get_generator(int resolution_length, string generator_filename);
@@ -7,6 +7,8 @@ int main(int argc, char** argv){
 	//set the maximal degree
 	int max_degree = std::atoi(argv[1]);
 	int resolution_length = std::atoi(argv[2]);
+	//the length of a previous run to be extended
+	int previous = argc>3 ? std::atoi(argv[3]) : -1;
 	//initialize the monomial index
 	monomial_index mon_index(max_degree);
 	
@@ -15,7 +17,7 @@ int main(int argc, char** argv){
 	filename += "_BP";
 	
 	//construct the operators for BP
-	BPInit BPoper(max_degree, resolution_length, filename0 + "etaL", filename0 + "R2L", filename0 + "delta", filename);
+	BPInit BPoper(max_degree, resolution_length, filename0, filename);
 	
 	//load the resolution table for BP/I
 //	BPoper.loadResolutionTables(filename0 + "ResTables");
@@ -24,7 +26,7 @@ int main(int argc, char** argv){
 	
 	std::cout << "starting resolution..." << std::flush;
 	//do the resolution
-	BPoper.resolve();
+	BPoper.resolve(previous);
 	
 	//construct the resolution
 	BPoper.resolution();
@@ -35,9 +37,11 @@ int main(int argc, char** argv){
 	//compute Bocstein table
 	BPoper.make_Boc();
 	
-	//compute the multiplicative structure
-	BPoper.mult_table();
-	BPoper.mult_theta(resolution_length);
+	//compute the multiplicative structure, h0 and the top thetas in one pass
+	BPoper.mult_tables();
+	
+	//compute the Massey products <c,3,h0>
+	BPoper.massey_table();
 	
 	return 0;
 }
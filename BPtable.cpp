@@ -14,25 +14,8 @@ int main(int argc, char** argv){
 	string filename = argv[1];
 	filename += "_";
 	
-	//construct rational operators
-	Q3_int Q3intoper;
-	Q3_Op Q3_oper;
-	BPQ_Op BPQ_oper(&Q3_oper,&Q3intoper,max_var);
-	
-	//output the structure data
-	std::fstream data_gens(filename + "structures", std::ios::out);
-	data_gens << BPQ_oper.show_li();
-	data_gens << BPQ_oper.show_vn();
-	data_gens << BPQ_oper.show_etaR();
-	data_gens.close();
-	
-	//construct the binary structure tables
-	std::fstream R2Lfile(filename + "R2L_gen", std::ios::out | std::ios::binary);
-	std::fstream deltafile(filename + "delta_gen", std::ios::out | std::ios::binary);
-	BPQ_oper.output_R2L(R2Lfile);
-	BPQ_oper.output_delta(deltafile);
-	R2Lfile.close();
-	deltafile.close();
+	//the structure data on the generators, computed with rational coefficients
+	make_generator_data(max_var, filename);
 	
 	//construct the integral operators
 	Z3_Op Z3_oper;
@@ -41,6 +24,8 @@ int main(int argc, char** argv){
 	matrix<BP>::moduleOper = &BP_oper.BPMod_opers;
 	
 	//construct the tables for the complete structure maps
+	//with the parameter resume, the entries already in the tables of a previous run are kept
+	bool resume = argc>2 && !strcmp(argv[2], "resume");
 	std::fstream ouput(filename + "Ls", std::ios::out);
-	BP_oper.make_tables(max_var, filename + "R2L_gen", filename + "delta_gen", filename + "etaL", filename + "R2L", filename + "delta", ouput);
+	BP_oper.make_tables(max_var, filename + "R2L_gen", filename + "delta_gen", filename + "etaL", filename + "R2L", filename + "delta", ouput, resume);
 }
@@ -1,8 +1,8 @@
 //Boc.cpp
 #include"Boc.h"
 
-int Boc_table::v_valuation(Z3 r, exponent){
-	return Z3Oper->valuation(r);
+int Boc_table::v_valuation(int v0, int){
+	return v0;
 }
 
 void Boc_tables::set_table(std::vector<algNov_table>*){
@@ -19,10 +19,7 @@ void Boc_tables::set_table(std::vector<Boc_table>* tbs){
 }
 
 int Boc_table::num_v(cycle_name cyc){
-	int res = 0;
-	for(unsigned i=1; i<cyc.first.size(); ++i)
-		res += cyc.first[i];
-	return res;
+	return cyc.v0 + total_deg(cyc.expo(), [](int){return 1;});
 }
 
 std::pair<std::pair<int,int>,string> Boc_table::output(SS_entry<cycle_name, Z3>& et, int k){
@@ -66,7 +63,7 @@ multiplication_table<cycle_name> Boc_table::Bname2Aname(algNov_table &Atable, in
 		//skip those tagged entries
 		if(tagged(tm)) continue;
 		//skip those entries divizible by v0 if we just want simple tables
-		if(simple && tm.cycle.first[0]>0) continue;
+		if(simple && tm.cycle.fil>0) continue;
 		//read the full cycle
 		auto v = tm.full_cycle;
 		//construct the new entry
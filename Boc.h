@@ -11,7 +11,7 @@ public:
 	Boc_table();
 	
 	//re-define the valuation so that it is given by the number of v0's
-	int v_valuation(Z3, exponent) override;
+	int v_valuation(int v0, int nv) override;
 	
 	//number of v's
 	int num_v(cycle_name);
@@ -4,12 +4,24 @@
 #include<sstream>
 #include<fstream>
 
-//the i-th power of p
+//initialize the powers of p
+void Qp_Op::set_prime(int p){
+	w = 0;
+	num_type B = 1;
+	while(B <= (num_type)UINT64_MAX / p){
+		B *= p;
+		++w;
+	}
+	pw.resize(2*w+1);
+	pw[0] = 1;
+	for(unsigned k=1; k<=2*w; ++k)
+		pw[k] = pw[k-1] * p;
+	cancelled = exact_zero;
+}
+
+//the i-th power of p, modulo p^(2w)
 num_type Qp_Op::power_p(unsigned i){
-	num_type res = 1;
-	for(unsigned k=0;k<i;++k)
-		res = safe_mult(res,prime());
-	return res;
+	return i<pw.size() ? pw[i] : 0;
 }
 
 //i-th power of p
@@ -20,183 +32,204 @@ int Qp_Op::power_p_int(unsigned i){
 	return res;
 }
 
-//addition of the numerator
+//addition of the numerator modulo p^(2w)
 inline num_type Qp_Op::safe_add(num_type x, num_type y){
-    return x+y;
+	num_type M = pw[2*w];
+	num_type s = x + y;
+	if(s < x || s >= M) s -= M;
+	return s;
 }
 
-//multiplication for the numerator
+//multiplication for the numerator modulo p^(2w), with words modulo p^w
+//x y = x0 y0 + (x0 y1 + x1 y0) p^w
 inline num_type Qp_Op::safe_mult(num_type x, num_type y) {
-    return x*y;
+	num_type B = pw[w];
+	uint64_t x0 = x % B, x1 = x / B, y0 = y % B, y1 = y / B;
+	num_type mid = ((num_type)x0 * y1 % B + (num_type)x1 * y0 % B) % B;
+	return safe_add((num_type)x0 * y0, mid * B);
+}
+
+//the zero modulo p^n
+inline Qp Qp_Op::zero_mod(int n){
+	if(n >= exact_zero)
+		return {(num_type)0, exact_zero, 0};
+	return {(num_type)0, (int16_t)n, 0};
 }
 
-//subtract the power of p's
+//subtract the power of p's, losing a digit of precision for each
 inline void Qp_Op::simplify(Qp &x) {
-	//convention for 0
-	if(x.numerator==0) {
-		x.valuation = 0;
-		return;
+	int p = prime();
+	while(x.precision > 0 && x.numerator % p == 0){
+		x.numerator /= p;
+		++x.valuation;
+		--x.precision;
 	}
+	//all the known digits are zero
+	if(x.precision == 0){
+		int a = x.valuation;
+		int c = cancelled;
+		while(a < c && !cancelled.compare_exchange_weak(c, a));
+		x = zero_mod(a);
+	}
+}
 
-	//return when the numerator is not divisible by p
-	if(x.numerator % ((num_type)prime()) != (num_type)0) return;
-
-	//divide by p
-	x.numerator /= (num_type) prime();
-	++x.valuation;
-
-	simplify(x);
+//the least absolute precision of the terms cancelled out so far
+int Qp_Op::cancelled_precision(){
+	return cancelled;
 }
 
-//output
-string Qp_Op::output(Qp x) { 
-    std::ostringstream fr;
-    fr << x.numerator;
-    return fr.str() + "(" + std::to_string(x.valuation) + ")"; 
+//output, the numerator is the representative of least absolute value
+string Qp_Op::output(Qp x) {
+	if(isZero(x))
+		return "0(0)";
+	num_type M = pw[x.precision];
+	bool negative = x.numerator > M/2;
+	num_type n = negative ? M - x.numerator : x.numerator;
+	string digits;
+	do{
+		digits = (char)('0' + (int)(n % 10)) + digits;
+		n /= 10;
+	}while(n != 0);
+	return (negative ? "-" : "") + digits + "(" + std::to_string(x.valuation) + ")";
 }
 
 //additions
 inline Qp Qp_Op::add(Qp const &x, Qp const &y){
+	//the absolute precision of the sum
+	int ax = x.valuation + x.precision, ay = y.valuation + y.precision;
+	int a = ax < ay ? ax : ay;
+	if(isZero(x) && isZero(y))
+		return zero_mod(a);
+	if(isZero(x) || isZero(y)){
+		Qp const &z = isZero(x) ? y : x;
+		if(a <= z.valuation)
+			return zero_mod(a);
+		int r = a - z.valuation;
+		return {z.numerator % pw[r], z.valuation, (int16_t)r};
+	}
 	//we need to make the denominators equal before addition
-	if(x.valuation<y.valuation)
-		return {safe_add(x.numerator, safe_mult(y.numerator,power_p(y.valuation-x.valuation))), x.valuation};
-	
-	if(x.valuation>y.valuation)
-		return {safe_add(y.numerator, safe_mult(x.numerator,power_p(x.valuation-y.valuation))), y.valuation};
-	
-	//if the denominators are already equal
-	Qp z = {safe_add(x.numerator,y.numerator), x.valuation};
+	int v = x.valuation < y.valuation ? x.valuation : y.valuation;
+	int r = a - v;
+	if(r > (int)(2*w)) r = 2*w;
+	num_type ux = x.valuation-v < (int)(2*w) ? safe_mult(x.numerator, pw[x.valuation-v]) : 0;
+	num_type uy = y.valuation-v < (int)(2*w) ? safe_mult(y.numerator, pw[y.valuation-v]) : 0;
+	Qp z = {safe_add(ux, uy) % pw[r], (int16_t)v, (int16_t)r};
 	//check if the numerator is divisible by p
-	simplify(z);
+	if(x.valuation == y.valuation)
+		simplify(z);
 	return z;
 }
 
 //addition
-inline Qp Qp_Op::add(Qp &&x, Qp &&y){ 
+inline Qp Qp_Op::add(Qp &&x, Qp &&y){
 	return add(x,y); }
 
 //zero elememnt
-inline Qp Qp_Op::zero() { 
-	return {(num_type)0,0}; }
-	
-//check if equal to zero
-inline bool Qp_Op::isZero(Qp const &x){ 
-	return x.numerator==(num_type)0; }
-	
+inline Qp Qp_Op::zero() {
+	return zero_mod(exact_zero); }
+
+//check if equal to zero, up to the precision
+inline bool Qp_Op::isZero(Qp const &x){
+	return x.precision == 0; }
+
 //the negative
-inline Qp Qp_Op::minus(Qp const &x){ 
-	return {-x.numerator, x.valuation}; }
+inline Qp Qp_Op::minus(Qp const &x){
+	if(isZero(x) || x.numerator == 0)
+		return x;
+	return {pw[x.precision] - x.numerator, x.valuation, x.precision}; }
 
 //multiplication
-inline Qp Qp_Op::multiply(Qp const &x, Qp const &y){ 
-	return {safe_mult(x.numerator,y.numerator), (int16_t)(x.valuation+y.valuation)}; }
-
-//unit map
-inline Qp Qp_Op::unit(int x){ 
-	Qp result = {(num_type)x,0};
-	simplify(result);
+inline Qp Qp_Op::multiply(Qp const &x, Qp const &y){
+	//a zero modulo p^n times p^v is a zero modulo p^(n+v)
+	if(isZero(x) || isZero(y)){
+		if(x.valuation == exact_zero || y.valuation == exact_zero)
+			return zero();
+		return zero_mod(x.valuation + y.valuation);
+	}
+	int r = x.precision < y.precision ? x.precision : y.precision;
+	return {safe_mult(x.numerator,y.numerator) % pw[r], (int16_t)(x.valuation+y.valuation), (int16_t)r}; }
+
+//unit map, which is exact
+inline Qp Qp_Op::unit(int x){
+	if(x == 0)
+		return zero();
+	int64_t n = x > 0 ? x : -(int64_t)x;
+	int16_t v = 0;
+	while(n % prime() == 0){
+		n /= prime();
+		++v;
+	}
+	Qp result = {(num_type)n, v, (int16_t)(2*w)};
+	if(x < 0)
+		result.numerator = pw[2*w] - result.numerator;
 	return result;
 }
 
 //check if an element is invertible
-inline  bool  Qp_Op::invertible(Qp const &x){ 
+inline  bool  Qp_Op::invertible(Qp const &x){
 	return !isZero(x); }
 
 //the inverse operation is not needed in this project
-inline Qp Qp_Op::inverse(Qp const &x) 
-{ 
+inline Qp Qp_Op::inverse(Qp const &x)
+{
 	std::cerr << "not implemented!"; abort(); }
 
 //IO operations
 inline void Qp_Op::save(Qp const &x, std::iostream& writer){
-	//transform the numerator
-	auto vr = save2vector(x.numerator);
-	//write the valuation
 	writer.write((char*)&x.valuation,2);
-	//write the numerator
-	int16_t l = vr.size();
-	writer.write((char*)&l,2);
-	writer.write((char*)vr.data(),l);
+	writer.write((char*)&x.precision,2);
+	writer.write((char*)&x.numerator,16);
 }
 
 //IO operations
 inline Qp Qp_Op::load(std::iostream& reader){
 	Qp result;
-	//read the valuation
 	reader.read((char*)&result.valuation,2);
-	//read the numerator
-	int16_t l;
-	reader.read((char*)&l,2);
-	std::vector<unsigned char> vr(l);
-	reader.read((char*)vr.data(),l);
-	//transform the numerator
-	result.numerator = load_vector(vr);
+	reader.read((char*)&result.precision,2);
+	reader.read((char*)&result.numerator,16);
 	return result;
 }
 
+//the constructor for Q3
+Q3_Op::Q3_Op(){
+	set_prime(3);
+}
+
 //the characteristic of the residue field for Q3
-inline int Q3_Op::prime(){ 
+inline int Q3_Op::prime(){
 	return 3;}
 
 //the constructor
-Qp Qp_Op::construct(int num, int16_t val){ 
-	return {(num_type)num,val}; }
+Qp Qp_Op::construct(int num, int16_t val){
+	Qp result = unit(num);
+	if(!isZero(result))
+		result.valuation += val;
+	return result;
+}
 
-//transform an element into an interger
+//transform an element into an interger, modulo p^w (3^40 for p=3)
 uint64_t Qp_Op::int_part(Qp x){
+	if(isZero(x)){
+		if(x.valuation < (int)w){
+			std::cerr << "precision lost! zero modulo " << prime() << "^" << x.valuation;
+			abort();
+		}
+		return 0;
+	}
 	if(x.valuation<0){
 		std::cout << output(x);
 		std::cerr << "not integral!";
 		abort();
 	}
-	num_type ip = x.numerator * power_p(x.valuation);
-	//the maximal number for an 64-bit unsigned integer
-	static const num_type t64 = 12157665459056928801U; // 3^40
-	//truncate the lower part
-	ip = ip % t64;
-	if(ip<0) ip+=t64;
-	
-	return (uint64_t) ip.get_ui();
-}
-
-//transform the numerator to a char*
-inline std::vector<unsigned char> Qp_Op::save2vector(num_type x){
-	std::vector<unsigned char> result;
-	if(x==0){
-		result.push_back(0);
-		return result;
-	}
-	
-	//save the sign
-	if(x>0)
-		result.push_back(1);
-	else
-		result.push_back(2);
-	
-	//save the 256-adic expression
-	while(x!=0){
-		num_type ns = x%256;
-		result.push_back((unsigned char) ns.get_ui());
-		x/=256;
-	}
-	
-	return result;
-}
-
-//transform a char* into the numerator
-inline num_type Qp_Op::load_vector(std::vector<unsigned char> const &rv){
-	num_type res=0;
-	
-	num_type vl = 1;
-	for(int i=1;i<(int)rv.size();++i){
-		res += vl*(num_type)rv[i];
-		vl *= 256;
+	if(x.valuation + x.precision < (int)w){
+		std::cout << output(x);
+		std::cerr << "precision lost!";
+		abort();
 	}
-    
-	//check the signe
-	if(rv[0]==2)
-		res=-res;
-	return res;
+	if(x.valuation >= (int)w)
+		return 0;
+	//truncate the lower part
+	return (uint64_t)(x.numerator % pw[w-x.valuation] * pw[x.valuation]);
 }
 
 void Qp_int::save(Qp const &x, std::iostream& writer){
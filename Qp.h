@@ -1,39 +1,63 @@
 //Qp.h
 #pragma once
+#ifdef QP_GMP
+#include"Qp_gmp.h"
+#else
 #include<vector>
-#include<gmpxx.h>
+#include<atomic>
 #include"algebra.h"
 
-//the type of the numerators
-typedef mpz_class num_type;
+//the type of the numerators, the units are kept modulo p^(2w), where p^w is the largest power of p below 2^64
+typedef unsigned __int128 num_type;
 
-//an p-rational number has a numerator and a valuation serving as the power of the denominator
+//an p-rational number is a unit times a power of p. The unit is only known modulo p^precision
+//with precision 0, it is a zero modulo p^valuation
 typedef struct {
 	num_type numerator;
 	int16_t valuation;
+	int16_t precision;
 } Qp;
 
 //operations on Qp
 class Qp_Op : public virtual RingOp<Qp>{
-	//operations on the numerators
+	//the number of digits in a word, and the powers of p up to p^(2w)
+	unsigned w;
+	std::vector<num_type> pw;
+
+	//the least absolute precision of the terms cancelled out in additions
+	std::atomic<int> cancelled;
+
+	//operations on the numerators modulo p^(2w)
 	num_type safe_add(num_type,num_type);
 	num_type safe_mult(num_type,num_type);
+
+	//the zero modulo p^n
+	Qp zero_mod(int n);
+protected:
+	//initialize the powers of p
+	void set_prime(int p);
 public:
+	//the valuation of an exact zero
+	static constexpr int16_t exact_zero = 16000;
+
 	//the residue characteristic
 	virtual int prime()=0;
-	
+
 	//i-th power of p
 	num_type power_p(unsigned i);
 	int power_p_int(unsigned i);
 
 	//kill off powers of p in numerator
 	void simplify(Qp &x);
-        
+
+	//the least absolute precision of the terms cancelled out so far
+	int cancelled_precision();
+
 	//IO operations
 	string output(Qp x);
 	void save(Qp const &x, std::iostream& writer);
 	Qp load(std::iostream& reader);
-	
+
 	//ring operations
 	Qp add(Qp const &x, Qp const &y);
 	Qp add(Qp &&x, Qp &&y);
@@ -44,22 +68,20 @@ public:
 	Qp unit(int x);
 	bool invertible (Qp const &x);
 	Qp inverse (Qp const &x);
-        
+
 	//the constructor
 	Qp construct(int num, int16_t val);
-    
-	//tranform of the numerator between char*
-	typedef unsigned char uchar;
-	std::vector<uchar> save2vector(num_type x);
-	num_type load_vector(std::vector<uchar> const&);
-        
-	//tranform into an unsigned integer
+
+	//tranform into an unsigned integer, modulo p^w
+	//this aborts if the precision is not enough
 	uint64_t int_part(Qp);
 };
-  
+
 //spectialize to p=3
 class Q3_Op : virtual public Qp_Op{
-    int prime();
+	int prime();
+public:
+	Q3_Op();
 };
 
 //the Qp operations with integral IO
@@ -73,3 +95,4 @@ class Q3_int : virtual public Qp_int, virtual public Q3_Op{
 public:
 	string output(Qp x);
 };
+#endif
@@ -0,0 +1,228 @@
+//Qp_gmp.cpp
+#include"Qp.h"
+#include<iostream>
+#include<sstream>
+#include<fstream>
+
+//initialize the powers of p
+void Qp_Op::set_prime(int prm){
+	p = prm;
+	powers.resize(max_power);
+	powers[0] = 1;
+	for(unsigned k=1; k<max_power; ++k)
+		powers[k] = powers[k-1] * p;
+}
+
+//the i-th power of p, from the table if it is there
+num_type Qp_Op::power_p(unsigned i){
+	if(i<powers.size())
+		return powers[i];
+	num_type res;
+	mpz_pow_ui(res.get_mpz_t(), p.get_mpz_t(), i);
+	return res;
+}
+
+//i-th power of p
+int Qp_Op::power_p_int(unsigned i){
+	int res = 1;
+	for(unsigned k=0;k<i;++k)
+		res = res*prime();
+	return res;
+}
+
+//subtract the power of p's
+inline void Qp_Op::simplify(Qp &x) {
+	//convention for 0
+	if(x.numerator==0) {
+		x.valuation = 0;
+		return;
+	}
+
+	//return when the numerator is not divisible by p
+	if(mpz_divisible_p(x.numerator.get_mpz_t(), p.get_mpz_t()) == 0) return;
+
+	//divide by all the powers of p
+	x.valuation += mpz_remove(x.numerator.get_mpz_t(), x.numerator.get_mpz_t(), p.get_mpz_t());
+}
+
+//output
+string Qp_Op::output(Qp x) { 
+    std::ostringstream fr;
+    fr << x.numerator;
+    return fr.str() + "(" + std::to_string(x.valuation) + ")"; 
+}
+
+//additions
+inline Qp Qp_Op::add(Qp const &x, Qp const &y){
+	//we need to make the denominators equal before addition
+	if(x.valuation!=y.valuation){
+		Qp const &lo = x.valuation<y.valuation ? x : y;
+		Qp const &hi = x.valuation<y.valuation ? y : x;
+		Qp z = {lo.numerator, lo.valuation};
+		unsigned d = hi.valuation-lo.valuation;
+		if(d<powers.size())
+			mpz_addmul(z.numerator.get_mpz_t(), hi.numerator.get_mpz_t(), powers[d].get_mpz_t());
+		else
+			z.numerator += hi.numerator * power_p(d);
+		return z;
+	}
+	
+	//if the denominators are already equal
+	Qp z;
+	mpz_add(z.numerator.get_mpz_t(), x.numerator.get_mpz_t(), y.numerator.get_mpz_t());
+	z.valuation = x.valuation;
+	//check if the numerator is divisible by p
+	simplify(z);
+	return z;
+}
+
+//addition, reusing the numerator of x
+inline Qp Qp_Op::add(Qp &&x, Qp &&y){
+	if(x.valuation!=y.valuation)
+		return add(x,y);
+	x.numerator += y.numerator;
+	simplify(x);
+	return std::move(x);
+}
+
+//zero elememnt
+inline Qp Qp_Op::zero() { 
+	return {(num_type)0,0}; }
+	
+//check if equal to zero
+inline bool Qp_Op::isZero(Qp const &x){ 
+	return x.numerator==(num_type)0; }
+	
+//the negative
+inline Qp Qp_Op::minus(Qp const &x){ 
+	return {-x.numerator, x.valuation}; }
+
+//multiplication
+inline Qp Qp_Op::multiply(Qp const &x, Qp const &y){ 
+	Qp z;
+	mpz_mul(z.numerator.get_mpz_t(), x.numerator.get_mpz_t(), y.numerator.get_mpz_t());
+	z.valuation = x.valuation+y.valuation;
+	return z; }
+
+//unit map
+inline Qp Qp_Op::unit(int x){ 
+	Qp result = {(num_type)x,0};
+	simplify(result);
+	return result;
+}
+
+//check if an element is invertible
+inline  bool  Qp_Op::invertible(Qp const &x){ 
+	return !isZero(x); }
+
+//the inverse operation is not needed in this project
+inline Qp Qp_Op::inverse(Qp const &x) 
+{ 
+	std::cerr << "not implemented!"; abort(); }
+
+//IO operations
+inline void Qp_Op::save(Qp const &x, std::iostream& writer){
+	//transform the numerator
+	auto vr = save2vector(x.numerator);
+	//write the valuation
+	writer.write((char*)&x.valuation,2);
+	//write the numerator
+	int16_t l = vr.size();
+	writer.write((char*)&l,2);
+	writer.write((char*)vr.data(),l);
+}
+
+//IO operations
+inline Qp Qp_Op::load(std::iostream& reader){
+	Qp result;
+	//read the valuation
+	reader.read((char*)&result.valuation,2);
+	//read the numerator
+	int16_t l;
+	reader.read((char*)&l,2);
+	std::vector<unsigned char> vr(l);
+	reader.read((char*)vr.data(),l);
+	//transform the numerator
+	result.numerator = load_vector(vr);
+	return result;
+}
+
+//the constructor for Q3
+Q3_Op::Q3_Op(){
+	set_prime(3);
+}
+
+//the characteristic of the residue field for Q3
+inline int Q3_Op::prime(){ 
+	return 3;}
+
+//the constructor
+Qp Qp_Op::construct(int num, int16_t val){ 
+	return {(num_type)num,val}; }
+
+//transform an element into an interger
+uint64_t Qp_Op::int_part(Qp x){
+	if(x.valuation<0){
+		std::cout << output(x);
+		std::cerr << "not integral!";
+		abort();
+	}
+	num_type ip = x.numerator * power_p(x.valuation);
+	//the maximal number for an 64-bit unsigned integer
+	static const num_type t64 = 12157665459056928801U; // 3^40
+	//truncate the lower part
+	ip = ip % t64;
+	if(ip<0) ip+=t64;
+	
+	return (uint64_t) ip.get_ui();
+}
+
+//transform the numerator to a char*
+inline std::vector<unsigned char> Qp_Op::save2vector(num_type x){
+	std::vector<unsigned char> result;
+	if(x==0){
+		result.push_back(0);
+		return result;
+	}
+	
+	//save the sign
+	if(x>0)
+		result.push_back(1);
+	else
+		result.push_back(2);
+	
+	//save the 256-adic expression
+	while(x!=0){
+		num_type ns = x%256;
+		result.push_back((unsigned char) ns.get_ui());
+		x/=256;
+	}
+	
+	return result;
+}
+
+//transform a char* into the numerator
+inline num_type Qp_Op::load_vector(std::vector<unsigned char> const &rv){
+	num_type res=0;
+	
+	num_type vl = 1;
+	for(int i=1;i<(int)rv.size();++i){
+		res += vl*(num_type)rv[i];
+		vl *= 256;
+	}
+    
+	//check the signe
+	if(rv[0]==2)
+		res=-res;
+	return res;
+}
+
+void Qp_int::save(Qp const &x, std::iostream& writer){
+	uint64_t w = this->int_part(x);
+	writer.write((char*)&w, 8);
+}
+
+string Q3_int::output(Qp x){
+	uint64_t w = this->int_part(x);
+	return std::to_string((int)w);
+}
@@ -1,6 +1,7 @@
 //SS.h
 #pragma once
 #include"matrices.h"
+#include<unordered_map>
 
 //class for the entries in a spectral sequence
 template<typename cycle_name, typename ring>
@@ -23,7 +24,7 @@ public:
 	ModuleOp<matrix_index, ring> *Modop;
         
 	//the index of tags and cycles
-	std::map<cycle_name, unsigned> tag_index, cycle_index;
+	std::unordered_map<cycle_name, unsigned> tag_index, cycle_index;
 	
 	//the filtration function
 	virtual int filtration(cycle_name)=0;
@@ -84,7 +85,7 @@ public:
 		
 		//if the searched entry is not tagged, then it is a nontrivial cycle
 		auto pas = it->second;
-		if(this->at(pas).tag.second==Invalid) return Untagged;
+		if(!tagged(this->at(pas))) return Untagged;
 		
 		//then we subtract the tagged entry from the cycle
 		auto nc = Modop->minus(this->at(pas).full_cycle);
@@ -139,7 +140,7 @@ public:
 	virtual std::set<std::pair<std::pair<int,int>,string>> output(int k, int pric){
 		std::set<std::pair<std::pair<int,int>,string>> lst;
 		for(auto tm : *this){
-			if((tm.tag.second==Invalid || diff_length(tm)!=0) && filtration(tm.cycle)<pric)
+			if((!tagged(tm) || diff_length(tm)!=0) && filtration(tm.cycle)<pric)
 				lst.emplace(output(tm,k));
 		}
 		return lst;
@@ -160,36 +161,57 @@ public:
 	}
 	
 	//construct the table form a set of candidate of tags
-	void make_table(int pric, matrix<ring>* M, SS_table& T){
+	//the candidates are taken in batches, whose boundaries are computed and simplified in parallel against the table before the batch
+	void make_table(int pric, matrix<ring>* M, SS_table& T, unsigned batch = 4096){
 		//construct the cycle_pot
-		auto pot = cycle_pot(pric);
+		auto pot_set = cycle_pot(pric);
 		//filter the cycle_pot, using the previoud table
-		filter_pot(pot, T);
+		filter_pot(pot_set, T);
 		
 		//construct the Curtis table. Note we start with tags of highest filtration
-		for(auto it = pot.rbegin(); it != pot.rend(); it++){
-			//get the canditate of the cycle
-			auto vs = get_tag(*it);
-			//get the boundary of the canditate
-			auto bs = M->maps_to(vs);
-
-			//try to add lower terms to make it a cycle
-			auto BT = simplify(bs,vs,pric);
+		std::vector<cycle_name> pot(pot_set.rbegin(), pot_set.rend());
+		for(unsigned b0 = 0; b0 < pot.size(); b0 += batch){
+			unsigned b1 = std::min(b0 + batch, (unsigned) pot.size());
+			std::vector<typename SS_entry<cycle_name, ring>::value_type> vss(b1-b0), bss(b1-b0);
+			std::vector<cycle_type> BTs(b1-b0);
+			
+			#pragma omp parallel for schedule(dynamic)
+			for(unsigned j=b0; j<b1; ++j){
+				//get the canditate of the cycle
+				vss[j-b0] = get_tag(pot[j]);
+				//get the boundary of the canditate
+				bss[j-b0] = M->maps_to(vss[j-b0]);
+				//try to add lower terms to make it a cycle
+				BTs[j-b0] = simplify(bss[j-b0],vss[j-b0],pric);
+			}
 			
-			//make the new entry
-			SS_entry<cycle_name, ring> neE;
-			//if the candidate can be made a cycle, then insert into the previous table
-			if(BT==Boundary){
-				neE = {invalid(), *it, Modop->zero(), vs}; 
-				T.insert(neE);
-			} //if we find a nontrivial tag, then insert into the current table
-			else{
-				//find the leading term if the boundary
-				unsigned led = leading_term(bs);
+			for(unsigned j=b0; j<b1; ++j){
+				auto &vs = vss[j-b0];
+				auto &bs = bss[j-b0];
+				auto BT = BTs[j-b0];
+				
+				//the entries found by simplify are not changed by the insertions, but a leading term not found may have been inserted by an earlier candidate of the batch, then continue the simplification
+				if(BT==NonFound){
+					unsigned led = leading_term(bs);
+					if(cycle_index.find(naming(bs.dataArray[led].coeficient, bs.dataArray[led].ind)) != cycle_index.end())
+						BT = simplify(bs,vs,pric);
+				}
+				
 				//make the new entry
-				auto bn = naming(bs.dataArray[led].coeficient, bs.dataArray[led].ind);
-				neE = {*it, bn, vs, bs};
-				insert(neE);
+				SS_entry<cycle_name, ring> neE;
+				//if the candidate can be made a cycle, then insert into the previous table
+				if(BT==Boundary){
+					neE = {invalid(), pot[j], Modop->zero(), vs}; 
+					T.insert(neE);
+				} //if we find a nontrivial tag, then insert into the current table
+				else{
+					//find the leading term if the boundary
+					unsigned led = leading_term(bs);
+					//make the new entry
+					auto bn = naming(bs.dataArray[led].coeficient, bs.dataArray[led].ind);
+					neE = {pot[j], bn, std::move(vs), std::move(bs)};
+					insert(neE);
+				}
 			}
 		}
 	}
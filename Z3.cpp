@@ -119,12 +119,21 @@ unsigned Z3_Op::valuation(Z3 x){
 	//convention for valuation of 0
 	//TODO: do we need to change max_val? I have no idea what's special about this number.
 	static constexpr int max_val = 35536;
-	if(isZero(x)) return max_val;
+	x %= MAX3;
+	if(x==0) return max_val;
 	
 	//valuation of invertible is 0
-	if(invertible(x)) return 0;
-	//for non-invertible elements
-	return valuation(x/prime()) + 1;
+	if(x % 3 != 0) return 0;
+	//for non-invertible elements, the valuation is less than 40, so it is found by dividing by 3^32, 3^16, ..., 3
+	static const uint64_t pows[6] = {1853020188851841ULL, 43046721ULL, 6561ULL, 81ULL, 9ULL, 3ULL};
+	static const unsigned exps[6] = {32, 16, 8, 4, 2, 1};
+	unsigned v = 0;
+	for(int i=0; i<6; ++i)
+		if(x % pows[i] == 0){
+			x /= pows[i];
+			v += exps[i];
+		}
+	return v;
 }
 
 //p^n
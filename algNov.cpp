@@ -8,30 +8,20 @@ BP_Op *algNov_table::BPoper;
 
 //filtration of a cycle
 int algNov_table::filtration(cycle_name cyc){
-	return cyc.first[0];
+	return cyc.fil;
 }
 
 //the filtration by number of v's
-int algNov_table::v_valuation(Z3 r, exponent e){
-	return Z3Oper->valuation(r) + total_deg(e, [](int){return 1;});
+int algNov_table::v_valuation(int v0, int nv){
+	return v0 + nv;
 }
 	
 //transform a term into a cycle name
 cycle_name algNov_table::naming(const Z3 &coeficient, matrix_index ind, primitive_data &P){
-	//get the exponent
-	exponent e = P[ind].coeficient;
-	//construct the cycle
-	std::vector<int> eo;
-	//first compute the algebraic Novikov filtration
-	eo.push_back(v_valuation(coeficient,e));
-	//then get the number of v0's
-	eo.push_back(Z3Oper->valuation(coeficient));
-	//then the exponent
-	for(int i=1; i<=maxVar; ++i)
-		eo.push_back(xnVal(e,i));
-	
-	//the cycle
-	return {eo, P[ind].gen_pos};
+	int v0 = Z3Oper->valuation(coeficient);
+	//the algebraic Novikov filtration, the number of v0's, the exponent and the generator
+	cycle_name res = {v_valuation(v0, P.num_v[ind]), v0, P.lex[ind], (int32_t) P[ind].gen_pos};
+	return res;
 }
 
 //transform a term into a cycle name, using Pcyc
@@ -44,15 +34,15 @@ unsigned algNov_table::leading_term(SS_entry<cycle_name, Z3>::value_type& v){
 	//case of zero
 	if(v.size()==0) return -1;
 	
-	//the current leading term
+	//find the leading term with the smallest cycle name, comparing the keys of the names
 	unsigned led = 0;
-	//the name of the i-th term
-	auto cn = [&v,this](int i){
-		return naming(v.dataArray[i].coeficient, v.dataArray[i].ind); };
-	//find the leading term with the smallest cycle name
+	unsigned __int128 led_key = naming(v.dataArray[0].coeficient, v.dataArray[0].ind).key();
 	for(unsigned i=1; i<v.size(); ++i){
-		if(cn(i) < cn(led))
+		auto k = naming(v.dataArray[i].coeficient, v.dataArray[i].ind).key();
+		if(k < led_key){
 			led = i;
+			led_key = k;
+		}
 	}
 	return led;
 }
@@ -69,12 +59,12 @@ algNov_table::algNov_table() : SS_table(&BPoper->Z3Mod_opers){}
 
 //check the entry is a tag or not
 bool algNov_table::tagged(const SS_entry<cycle_name,Z3> &et){
-	return et.tag.second != Invalid;
+	return et.tag.gen != Invalid;
 }
 
 cycle_name algNov_table::invalid(){
-	std::vector<int> vd;
-	return std::make_pair(vd,Invalid);
+	cycle_name res = {0, 0, 0, Invalid};
+	return res;
 }
 
 //construct the cycle pot. pot has additional leading number for sorting reasons...
@@ -87,8 +77,8 @@ std::set<cycle_name> algNov_table::cycle_pot(int pric){
 		int l = filtration(s);
 		for(int j=0; j+l<=pric; ++j){
 			//construct ((l+j, j, v1^e1, ...), gen_ind)
-			s.first[0] = j+l;
-			s.first[1] = j;
+			s.fil = j+l;
+			s.v0 = j;
 			res.emplace(s);
 		}
 	}	
@@ -98,10 +88,13 @@ std::set<cycle_name> algNov_table::cycle_pot(int pric){
 //output of cycle names
 string algNov_table::output(cycle_name sn, int k){
 	string res;
-	for(unsigned i=1; i<sn.first.size(); ++i)
-		if(sn.first[i]!=0)
-			res += "v" + std::to_string(i-1) + "^" + std::to_string(sn.first[i]);
-	res += "[" + std::to_string(k) + "-" + std::to_string(sn.second) + "]";
+	if(sn.v0!=0)
+		res += "v0^" + std::to_string(sn.v0);
+	exponent e = sn.expo();
+	for(int i=1; i<=maxVar; ++i)
+		if(xnVal(e,i)!=0)
+			res += "v" + std::to_string(i) + "^" + std::to_string(xnVal(e,i));
+	res += "[" + std::to_string(k) + "-" + std::to_string(sn.gen) + "]";
 	return res;
 }
 
@@ -120,12 +113,21 @@ std::pair<std::pair<int,int>,string> algNov_table::output(SS_entry<cycle_name, Z
 	return std::make_pair(degs, res + "\t|deg=(" + std::to_string(degs.first) + "," + std::to_string(degs.second)+ ")");
 }
 
-//save the cycle  name
+//save the cycle  name, as the list (filtration, v0, v1, ...) followed by the generator, the list being empty for the invalid name
 void algNov_table::save(cycle_name nm, std::iostream& fl){
-	unsigned ls = nm.first.size();
+	int eo[2+maxVar];
+	unsigned ls = 0;
+	if(nm.gen != Invalid){
+		ls = 2+maxVar;
+		eo[0] = nm.fil;
+		eo[1] = nm.v0;
+		exponent e = nm.expo();
+		for(int i=1; i<=maxVar; ++i)
+			eo[i+1] = xnVal(e,i);
+	}
 	fl.write((char*)&ls, sizeof(unsigned));
-	fl.write((char*)nm.first.data(), ls*sizeof(int));
-	fl.write((char*)&nm.second, sizeof(int));
+	fl.write((char*)eo, ls*sizeof(int));
+	fl.write((char*)&nm.gen, sizeof(int));
 }
 
 //save the entry
@@ -140,10 +142,10 @@ void algNov_table::save(SS_entry<cycle_name, Z3>& et, std::iostream& fl){
 cycle_name algNov_table::load(std::iostream& fl){
 	unsigned ls;
 	fl.read((char*)&ls, sizeof(unsigned));
-	cycle_name res;
-	res.first.resize(ls);
-	fl.read((char*)res.first.data(), ls*sizeof(int));
-	fl.read((char*)&res.second, sizeof(int));
+	std::vector<int> eo(std::max(ls, 2u+maxVar), 0);
+	fl.read((char*)eo.data(), ls*sizeof(int));
+	cycle_name res = {eo[0], eo[1], lex_pack(pack(eo.data()+2)), 0};
+	fl.read((char*)&res.gen, sizeof(int));
 	return res;
 }
 
@@ -158,11 +160,11 @@ void algNov_table::load(SS_entry<cycle_name, Z3>& et, std::iostream& fl){
 //construct a vector using the primitive data
 SS_entry<cycle_name, Z3>::value_type algNov_table::make_vec(cycle_name cyc, primitive_data& P, ModuleOp<matrix_index,Z3> *Modop, Z3_Op *Z3Oper){ 
 	//construct the exponent
-	auto e = pack(cyc.first.data()+2);
+	auto e = cyc.expo();
 	//find the entry
-	auto n = P.prim_index[{(matrix_index)cyc.second, e}];
+	auto n = P.find({(matrix_index)cyc.gen, e});
 	//construct the term v0^e0v1^e1...[gen_pos]
-	return Modop->singleton(n,Z3Oper->power_p(cyc.first[1]));
+	return Modop->singleton(n,Z3Oper->power_p(cyc.v0));
 }
 
 //construct a full tag from the leading term
@@ -172,9 +174,9 @@ SS_entry<cycle_name, Z3>::value_type algNov_table::get_tag(cycle_name tag){
 //the degree of cycle
 int algNov_table::degree(cycle_name cyc){
 	//get the exponent of cyc = ((fil, e0,e1,...),gen_pos)
-	exponent e = pack(cyc.first.data()+2);
+	exponent e = cyc.expo();
 	//find the position of v^e[gen_pos]
-	int n = Pcyc->prim_index[{(matrix_index)cyc.second,e}];
+	int n = Pcyc->find({(matrix_index)cyc.gen,e});
 	//get the degre
 	return Pcyc->gen_deg[n];
 }
@@ -182,11 +184,7 @@ int algNov_table::degree(cycle_name cyc){
 //construct the table using the complex    
 void  algNov_tables::table_of_complex(BPComplex& Comp, int pric){
 	//initialize primitive data
-	tables[0]->Pcyc = &Comp.Prims[0];
-	for(unsigned i=0; i<Comp.size(); ++i){
-		tables[i]->Ptag = &Comp.Prims[i-1];
-		tables[i]->Pcyc = &Comp.Prims[i];
-	}
+	set_complex(Comp);
 	//construct tables
 	for(unsigned i=1; i<Comp.size(); ++i){
 		std::cout << "\n" << "table:" << i << "\n" << std::flush;
@@ -194,6 +192,15 @@ void  algNov_tables::table_of_complex(BPComplex& Comp, int pric){
 	}
 }
 
+//set the primitive data of the tables
+void algNov_tables::set_complex(BPComplex& Comp){
+	tables[0]->Pcyc = &Comp.Prims[0];
+	for(unsigned i=0; i<Comp.size(); ++i){
+		tables[i]->Ptag = &Comp.Prims[i-1];
+		tables[i]->Pcyc = &Comp.Prims[i];
+	}
+}
+
 //out put the algebraic Novikov table
 string algNov_tables::output_tables(){
 	string res;
@@ -241,7 +248,7 @@ void algNov_tables::set_table(std::vector<algNov_table>* tbs){
 
 //check if a name is valid
 bool algNov_table::valid(const cycle_name& cyc){
-	return cyc.second != Invalid;
+	return cyc.gen != Invalid;
 }
 
 std::set<std::pair<std::pair<int,int>,string>> algNov_table::output_table(int k, int pric){
@@ -3,10 +3,41 @@
 #include"BP.h"
 #include"SS.h"
 #include"BPcomplex.h"
+#include<tuple>
 
-//the type of the name of cycles
-//((filtration, v0, v1, v2, \dots), gen_ind)
-typedef std::pair<std::vector<int>,int> cycle_name; // gen_ind, v0, v1, ...
+//the name of the cycle v0^v0 v1^e1 v2^e2 ... [gen] in the filtration fil, packed in 128 bits
+//the exponents of v1, v2, ... are packed with v1 the most significant, so the names compare as ((fil, v0, e1, e2, ...), gen)
+struct cycle_name{
+	int32_t fil, v0;
+	uint32_t lex;
+	int32_t gen;
+	
+	//the exponent of v1, v2, ...
+	exponent expo() const{
+		return lex_unpack(lex); }
+	
+	//the key of a valid name, in the same order as the names
+	unsigned __int128 key() const{
+		return ((unsigned __int128) (((uint64_t) fil << 32) | (uint32_t) v0) << 64) | (((uint64_t) lex << 32) | (uint32_t) gen); }
+	
+	//comparisons
+	bool operator<(cycle_name const &y) const{
+		return std::tie(fil, v0, lex, gen) < std::tie(y.fil, y.v0, y.lex, y.gen); }
+	bool operator==(cycle_name const &y) const{
+		return fil==y.fil && v0==y.v0 && lex==y.lex && gen==y.gen; }
+};
+
+//the hash of cycle names
+namespace std{
+	template<>
+	struct hash<cycle_name>{
+		size_t operator()(cycle_name const &c) const{
+			uint64_t a = ((uint64_t) (uint32_t) c.fil << 32) | (uint32_t) c.v0;
+			uint64_t b = ((uint64_t) c.lex << 32) | (uint32_t) c.gen;
+			return std::hash<uint64_t>()(a * 0x9E3779B97F4A7C15ULL ^ b);
+		}
+	};
+}
 
 //the class of algebraic Novikov spectral sequences
 class algNov_table : virtual public SS_table<cycle_name, Z3>{
@@ -24,8 +55,8 @@ public:
 	//the space for the cycles
 	primitive_data *Pcyc;
 
-	//the filtration by number of v's
-	virtual int v_valuation(Z3, exponent);
+	//the filtration by number of v's, given the number of v0's and the number of the other v's
+	virtual int v_valuation(int v0, int nv);
 	
 	//filtration of a cycle
 	int filtration(cycle_name);
@@ -89,6 +120,8 @@ public:
 	void set_table(std::vector<algNov_table>*);
 	//construct the table from a complex of primitives
 	void table_of_complex(BPComplex&,int pric);
+	//set the primitive data of the tables
+	void set_complex(BPComplex&);
 	//output the table
 	string output_tables();
 	//IO operations
@@ -0,0 +1,128 @@
+//checkpoint.cpp
+#include"checkpoint.h"
+#include<algorithm>
+#include<fstream>
+#include<iostream>
+#include<sstream>
+#include<unistd.h>
+
+//constructor, loading the manifest if it exists
+checkpoint::checkpoint(string manifest_name){
+	manifest = manifest_name;
+	std::fstream reader(manifest, std::ios::in);
+	string line;
+	while(std::getline(reader, line)){
+		std::istringstream ls(line);
+		string stage;
+		int step;
+		record rc;
+		if(ls >> stage >> step >> rc.file >> rc.begin >> rc.end >> rc.sum)
+			stages[stage][step].push_back(rc);
+	}
+}
+
+//write the manifest, 6 fields per line: stage, step, file, begin, end, checksum
+void checkpoint::write(){
+	std::fstream writer(temporary(manifest), std::ios::out | std::ios::trunc);
+	for(auto &sg : stages)
+		for(auto &st : sg.second)
+			for(auto &rc : st.second)
+				writer << sg.first << " " << st.first << " " << rc.file << " " << rc.begin << " " << rc.end << " " << rc.sum << "\n";
+	writer.close();
+	commit(manifest);
+}
+
+//the size of a file
+uint64_t checkpoint::file_size(string filename){
+	std::fstream f(filename, std::ios::in | std::ios::binary | std::ios::ate);
+	if(!f.is_open()) return 0;
+	return f.tellg();
+}
+
+//the FNV-1a checksum of a segment of a file
+uint64_t checkpoint::checksum(string filename, uint64_t begin, uint64_t end){
+	std::fstream f(filename, std::ios::in | std::ios::binary);
+	f.seekg(begin);
+	uint64_t h = 14695981039346656037ULL;
+	std::vector<char> buf(1<<20);
+	while(begin < end && f){
+		uint64_t n = std::min<uint64_t>(buf.size(), end-begin);
+		f.read(buf.data(), n);
+		for(uint64_t i=0; i<(uint64_t)f.gcount(); ++i){
+			h ^= (unsigned char) buf[i];
+			h *= 1099511628211ULL;
+		}
+		begin += f.gcount();
+	}
+	return h;
+}
+
+//check that a segment is still intact
+bool checkpoint::intact(const record &rc){
+	return file_size(rc.file) >= rc.end && checksum(rc.file, rc.begin, rc.end) == rc.sum;
+}
+
+//record a completed step, each file is covered from where the previous steps have left it
+void checkpoint::complete(string stage, int step, std::vector<string> const &files){
+	auto &steps = stages[stage];
+	std::vector<record> rcs;
+	for(auto &fn : files){
+		record rc = {fn, 0, file_size(fn), 0};
+		for(auto &st : steps)
+			if(st.first < step)
+				for(auto &pr : st.second)
+					if(pr.file == fn && pr.end <= rc.end && pr.end > rc.begin)
+						rc.begin = pr.end;
+		rc.sum = checksum(fn, rc.begin, rc.end);
+		rcs.push_back(rc);
+	}
+	steps[step] = rcs;
+	write();
+}
+
+//tell if a step is completed and intact
+bool checkpoint::completed(string stage, int step){
+	auto sg = stages.find(stage);
+	if(sg == stages.end()) return false;
+	auto st = sg->second.find(step);
+	if(st == sg->second.end()) return false;
+	for(auto &rc : st->second)
+		if(!intact(rc)){
+			std::cerr << rc.file << " is changed since " << stage << " " << step << " was completed\n";
+			return false;
+		}
+	return true;
+}
+
+//forget a stage
+void checkpoint::reset(string stage){
+	if(stages.erase(stage))
+		write();
+}
+
+//resume a stage from the last completed step
+int checkpoint::resume(string stage){
+	int last = -1;
+	while(completed(stage, last+1))
+		++last;
+	
+	//drop the later records
+	auto &steps = stages[stage];
+	steps.erase(steps.upper_bound(last), steps.end());
+	if(steps.empty())
+		stages.erase(stage);
+	write();
+	if(last < 0)
+		return last;
+	
+	//cut the files back to the sizes at the last step
+	std::map<string, uint64_t> sizes;
+	for(auto &st : stages[stage])
+		for(auto &rc : st.second)
+			sizes[rc.file] = std::max(sizes[rc.file], rc.end);
+	for(auto &fs : sizes)
+		if(file_size(fs.first) > fs.second && truncate(fs.first.c_str(), fs.second) != 0)
+			std::cerr << "fail to cut " << fs.first << "\n";
+	std::cout << stage << " resumes after the step " << last << "\n";
+	return last;
+}
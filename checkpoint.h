@@ -0,0 +1,52 @@
+//checkpoint.h
+#pragma once
+#include<cstdio>
+#include<cstdint>
+#include<map>
+#include<vector>
+#include<string>
+
+using std::string;
+
+//the manifest of a run, recording the completed steps of each stage with checksums of what they wrote
+class checkpoint{
+	//the file of the manifest
+	string manifest;
+	//the segment of an output file written by a step
+	typedef struct{
+		string file;
+		uint64_t begin, end, sum;
+	} record;
+	//the records of the completed steps of each stage, the step -1 stands for the whole stage
+	std::map<string, std::map<int, std::vector<record>>> stages;
+	
+	//write the manifest through a temporary file
+	void write();
+	//check that a segment is still intact
+	bool intact(const record&);
+public:
+	//constructor, loading the manifest if it exists
+	checkpoint(string manifest_name);
+	
+	//the size of a file, 0 if it does not exist
+	static uint64_t file_size(string filename);
+	//the checksum of a segment of a file
+	static uint64_t checksum(string filename, uint64_t begin, uint64_t end);
+	
+	//record a completed step of a stage, with the files it has written
+	void complete(string stage, int step, std::vector<string> const &files);
+	//tell if a step of a stage is completed and its outputs are intact
+	bool completed(string stage, int step=-1);
+	//forget a stage
+	void reset(string stage);
+	//the last step such that all the steps up to it are completed, -1 if none
+	//the records after it are dropped, and the files are cut back to their sizes at that step
+	int resume(string stage);
+	
+	//the temporary file to write an output
+	static string temporary(string filename){
+		return filename + ".part"; }
+	//move a finished output to its place
+	static void commit(string filename){
+		std::rename(temporary(filename).c_str(), filename.c_str()); }
+};
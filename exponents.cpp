@@ -107,6 +107,23 @@ exponent pack(const exponentArry &eps){
 	return res;
 }
 
+//repack an exponent in the lexicographic order
+uint32_t lex_pack(exponent e){
+	uint32_t res = 0;
+	for(int i=1; i<=maxVar; ++i)
+		res = res*xnMaxExpo[i] + xnVal(e,i);
+	return res;
+}
+
+//the exponent of a lexicographic packing
+exponent lex_unpack(uint32_t l){
+	int eps[maxVar];
+	for(int i=maxVar; i>=1; --i){
+		eps[i-1] = l % xnMaxExpo[i];
+		l /= xnMaxExpo[i];
+	}
+	return pack(eps);
+}
 
 //save the list of exponents
 void save_expArry(exponentArry eps,std::iostream &writer){
@@ -44,6 +44,11 @@ exponent vars(int n);
 //construct an exponent
 exponent pack(const int*);
 exponent pack(const exponentArry&);
+
+//repack an exponent so that the numerical order is the lexicographic order, x1 being the most significant
+uint32_t lex_pack(exponent e);
+//the inverse of lex_pack
+exponent lex_unpack(uint32_t l);
   
 //output e
 string output(exponent e, string name = "x");
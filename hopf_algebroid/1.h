@@ -2,6 +2,8 @@
 #pragma once
 
 #include"matrices.h"
+#include"checkpoint.h"
 #include<algorithm>
+#include<atomic>
 #include<fstream>
 
@@ -2,56 +2,51 @@
 template<typename ring, typename algebroid>
 template<typename degree_type>
 void Hopf_Algebroid<ring,algebroid>::quotient(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> inverse_ind, comodule_generic<algebroid,degree_type> &result){
-	//get the rank of the quotient comodule
-	result.base_module.rank = inverse_ind.size();
+	quotient(X, quot, inverse_ind, result, false);
+}
 
-	//compute the degrees of the generators of the quotient
-	result.base_module.degree.resize(inverse_ind.size());
-	for(unsigned i=0; i<inverse_ind.size(); ++i)
-		result.base_module.degree[i] = X->degree(inverse_ind[i]);
-	std::function<vectors<matrix_index,algebroid>(const algebroid&, const vectors<matrix_index,ring>&)> right_mult = [this] (const algebroid& A, const vectors<matrix_index,ring> &V){
-		return right_scalor_mult(A,V); };
-	
-	//compose the quotien matrix and the coaction matrix. Note that we need to first apply the right unit to the quotient matrix
-	std::function<vectors<matrix_index,algebroid>(int)> coactor = [X,quot,&inverse_ind,right_mult,this] (int i){
-		vectors<matrix_index,algebroid> coa = X->coaction(inverse_ind[i]);
-		AbGroupOp<vectors<matrix_index,algebroid>> *adop = algebroidModuleOper;
-		std::cout << "\r" << i << "/" << inverse_ind.size() << std::flush;
-		return quot->maps_to(coa,right_mult, adop); 
-	};
-	std::cout << "computing the coactions...\n" << std::flush;
-	result.coaction_matrix->construct(inverse_ind.size(), coactor);
+//compute the quotient comodule, with the coactions in parallel
+template<typename ring, typename algebroid>
+template<typename degree_type>
+void Hopf_Algebroid<ring,algebroid>::quotient_p(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> inverse_ind, comodule_generic<algebroid,degree_type> &result){
+	quotient(X, quot, inverse_ind, result, true);
 }
 
-#include"matrices_mem.h"
-//compute the quotient comodule
+//compute the quotient comodule. The rows of quot are read in place, and each coaction is saved once it is computed
 template<typename ring, typename algebroid>
 template<typename degree_type>
-void Hopf_Algebroid<ring,algebroid>::quotient_p(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot0, std::vector<matrix_index> inverse_ind, comodule_generic<algebroid,degree_type> &result){
-	//load the quot matrix
-	matrix_mem<ring> quot1;
-	matrix<ring> *quot = &quot1;
-	quot->construct(quot0);
-	
+void Hopf_Algebroid<ring,algebroid>::quotient(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> const &inverse_ind, comodule_generic<algebroid,degree_type> &result, bool parallel){
+	unsigned n = inverse_ind.size();
 	//get the rank of the quotient comodule
-	result.base_module.rank = inverse_ind.size();
-	
+	result.base_module.rank = n;
+
 	//compute the degrees of the generators of the quotient
-	result.base_module.degree.resize(inverse_ind.size());
-	for(unsigned i=0; i<inverse_ind.size(); ++i)
+	result.base_module.degree.resize(n);
+	for(unsigned i=0; i<n; ++i)
 		result.base_module.degree[i] = X->degree(inverse_ind[i]);
-	std::function<vectors<matrix_index,algebroid>(const algebroid&, const vectors<matrix_index,ring>&)> right_mult = [this] (const algebroid& A, const vectors<matrix_index,ring> &V){
-		return right_scalor_mult(A,V); };
-		
-		//compose the quotien matrix and the coaction matrix. Note that we need to first apply the right unit to the quotient matrix
-		std::function<vectors<matrix_index,algebroid>(int)> coactor = [X,quot,&inverse_ind,right_mult,this] (int i){
-			vectors<matrix_index,algebroid> coa = X->coaction(inverse_ind[i]);
-			AbGroupOp<vectors<matrix_index,algebroid>> *adop = algebroidModuleOper;
-			std::cout << "\r" << i << "/" << inverse_ind.size() << std::flush;
-			return quot->maps_to_p(coa,right_mult, adop); 
-		};
-		std::cout << "computing the coactions...\n" << std::flush;
-		result.coaction_matrix->construct_parallel(inverse_ind.size(), coactor);
+	
+	//the coactions of high degrees have more terms, so they are computed first
+	std::vector<unsigned> order(n);
+	for(unsigned i=0; i<n; ++i)
+		order[i] = i;
+	if(parallel){
+		quot->share_rows();
+		std::stable_sort(order.begin(), order.end(), [X,&inverse_ind](unsigned i, unsigned j){
+			return cofree_comodule<algebroid,degree_type>::underlyingDeg(X->degree(inverse_ind[i])) > cofree_comodule<algebroid,degree_type>::underlyingDeg(X->degree(inverse_ind[j])); });
+	}
+	
+	//compose the quotien matrix and the coaction matrix. Note that we need to first apply the right unit to the quotient matrix
+	std::cout << "computing the coactions...\n" << std::flush;
+	result.coaction_matrix->clear();
+	result.coaction_matrix->set_rank(n);
+	std::atomic<unsigned> done(0);
+	#pragma omp parallel for schedule(dynamic) if(parallel)
+	for(unsigned k=0; k<n; ++k){
+		unsigned i = order[k];
+		vectors<matrix_index,algebroid> coa = X->coaction(inverse_ind[i]);
+		result.coaction_matrix->insert(i, right_maps_to(coa, quot, parallel));
+		std::cout << "\r" << ++done << "/" << n << std::flush;
+	}
 }
 
 //scalor multiplication using the right unit
@@ -62,3 +57,12 @@ vectors<matrix_index, algebroid> Hopf_Algebroid<ring,algebroid>::right_scalor_mu
 	std::function<algebroid(ring const&)> rule = [this,&A] (ring const &r) { return algebroidRingOper->multiply(A,etaR(r)); };
 	return moduleOper->termwise_operation(rule, V);
 }
+
+//the sum of the coefficients of coa times the rows of M, with the rows converted using the right unit
+template<typename ring, typename algebroid>
+vectors<matrix_index, algebroid> Hopf_Algebroid<ring,algebroid>::right_maps_to (vectors<matrix_index, algebroid> const &coa, matrix<ring> *M, bool parallel) {
+	std::function<vectors<matrix_index,algebroid>(const algebroid&, const vectors<matrix_index,ring>&)> right_mult = [this] (const algebroid& A, const vectors<matrix_index,ring> &V){
+		return right_scalor_mult(A,V); };
+	AbGroupOp<vectors<matrix_index,algebroid>> *adop = algebroidModuleOper;
+	return parallel ? M->maps_to_p(coa,right_mult, adop) : M->maps_to(coa,right_mult, adop);
+}
@@ -20,7 +20,8 @@ vectors<matrix_index,ring> cofree_comodule<algebroid,degree_type>::multiply_usin
 	int k =  i - position_of_gens[p];
 	auto v = mult_table.find(k);
 	
-	std::function<matrix_index(matrix_index)> shifting = [p,this] (matrix_index j) {
-		return j + this->position_of_gens[p]; };
-	return mult_table.moduleOper->re_index(shifting, v);
+	//the shift keeps the order of the indices
+	for(auto &tm : v.dataArray)
+		tm.ind += position_of_gens[p];
+	return v;
 }
@@ -27,6 +27,8 @@ void cofree_comodule<algebroid,degree_type>::load(std::iostream &reader){
 	uint32_t n_gens; reader.read((char*)&n_gens, 4);
 	position_of_gens.resize(n_gens);
 	reader.read((char*)position_of_gens.data(), n_gens*4);
+	summand_index.clear();
+	index_summands();
 }
 
 //default generator
@@ -51,8 +53,32 @@ unsigned cofree_comodule<algebroid,degree_type>::findPos(unsigned startPos, unsi
 
 template<typename algebroid, typename degree_type>
 unsigned cofree_comodule<algebroid,degree_type>::findPos(unsigned n) const{ 
+	if(summand_index.size() == (unsigned)total_rank && n < summand_index.size())
+		return summand_index[n];
 	return findPos(0,position_of_gens.size(),n); }
 
+//extend the summands of the module generators to the total rank, the generators are added at the end
+template<typename algebroid, typename degree_type>
+void cofree_comodule<algebroid,degree_type>::index_summands(){
+	if(summand_index.size() > (unsigned)total_rank)
+		summand_index.clear();
+	unsigned p = summand_index.empty() ? 0 : summand_index.back();
+	summand_index.reserve(total_rank);
+	for(unsigned n = summand_index.size(); n<(unsigned)total_rank; ++n){
+		while(p+1 < position_of_gens.size() && position_of_gens[p+1] <= n)
+			++p;
+		summand_index.push_back(p);
+	}
+}
+
+//shift the indices of a coaction on a summand, which keeps their order
+template<typename algebroid, typename degree_type>
+vectors<matrix_index, algebroid> cofree_comodule<algebroid,degree_type>::shifted(vectors<matrix_index, algebroid> &&v, matrix_index pos){
+	for(auto &tm : v.dataArray)
+		tm.ind += pos;
+	return std::move(v);
+}
+
 //the rank of the comodule
 template<typename algebroid, typename degree_type>
 int cofree_comodule<algebroid,degree_type>::rank() const{ 
@@ -62,9 +88,7 @@ int cofree_comodule<algebroid,degree_type>::rank() const{
 template<typename algebroid, typename degree_type>
 vectors<matrix_index, algebroid> cofree_comodule<algebroid,degree_type>::coaction(int i) const{
 	unsigned pos = findPos(i);
-	std::function<matrix_index(matrix_index)> shifting = [pos, this] (matrix_index k){
-		return k + this->position_of_gens[pos]; };
-	return modOpers->re_index(shifting, cofree_coaction(i-position_of_gens[pos]));
+	return shifted(cofree_coaction(i-position_of_gens[pos]), position_of_gens[pos]);
 }
 
 //the degree of the generators
@@ -81,6 +105,7 @@ void cofree_comodule<algebroid,degree_type>::direct_sum( cofree_comodule<algebro
 	for(auto p: Y.position_of_gens)
 		position_of_gens.push_back(p+total_rank);
 	total_rank+=Y.total_rank;
+	index_summands();
 }
 		
 // find if n is a cogenerators
@@ -16,6 +16,11 @@ public:
 	std::vector<uint32_t> position_of_gens;
 	//the rank of the underlying module
 	int total_rank;
+	//the summand of each module generator, for the generators below its size
+	std::vector<uint32_t> summand_index;
+	
+	//extend the summands of the module generators to the total rank
+	void index_summands();
 	 
 	//get a searching index for the positions of the co-generators inside the set of module generators
 	std::map<matrix_index,matrix_index> gen_pos_index();
@@ -27,7 +32,7 @@ public:
 	//default constructor
 	cofree_comodule();
 	
-	//locate in which cofree summand is a module generator lying
+	//locate in which cofree summand is a module generator lying, from the summand index when it is complete
 	unsigned findPos(unsigned startPos, unsigned endPos, unsigned n) const;
 	unsigned findPos(unsigned n) const;
 
@@ -55,4 +60,7 @@ public:
 	
 	//add the degrees
 	static degree_type add_degree(degree_type,degree_type);
+	
+	//shift the indices of a coaction on a summand by its position, which keeps their order
+	static vectors<matrix_index, algebroid> shifted(vectors<matrix_index, algebroid> &&v, matrix_index pos);
  };
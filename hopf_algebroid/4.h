@@ -32,7 +32,10 @@ public:
 	string maps_file_name;
 	 
 	//convert a vector V into a vector over algebroid using the right unit and then scalor multiply with A
-	vectors<matrix_index, algebroid> right_scalor_mult (algebroid const &A, vectors<matrix_index, ring> const &V);
+	virtual vectors<matrix_index, algebroid> right_scalor_mult (algebroid const &A, vectors<matrix_index, ring> const &V);
+	
+	//the sum of the coefficients of coa times the rows of M, with the rows converted using the right unit
+	virtual vectors<matrix_index, algebroid> right_maps_to (vectors<matrix_index, algebroid> const &coa, matrix<ring> *M, bool parallel);
 	
 	//initialize the structure functions of the algebroid
 	template<typename degree_type>
@@ -55,18 +58,31 @@ public:
 	void quotient(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> inverse_ind, comodule_generic<algebroid,degree_type> &result);
 	template<typename degree_type>
 	void quotient_p(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> inverse_ind, comodule_generic<algebroid,degree_type> &result);
+	template<typename degree_type>
+	void quotient(const CoModule<algebroid,degree_type> *X, matrix<ring> *quot, std::vector<matrix_index> const &inverse_ind, comodule_generic<algebroid,degree_type> &result, bool parallel);
 	
 	//embed a comodule into a cofree comodule
 	template<typename degree_type>
 	cofree_comodule<algebroid,degree_type> embed2cofree(const CoModule<algebroid,degree_type> *X, matrix<ring> *inj, curtis_table<ring> *table, std::vector<int> *gens, matrix<ring>*, std::vector<int> *basis_order, std::iostream&);
+	//reducing the rows of each degree in parallel
+	template<typename degree_type>
+	cofree_comodule<algebroid,degree_type> embed2cofree_p(const CoModule<algebroid,degree_type> *X, matrix<ring> *inj, curtis_table<ring> *table, std::vector<int> *gens, matrix<ring>*, std::vector<int> *basis_order, std::iostream&);
 	
 	//one step in constructing a relative injective resolution
 	template<typename degree_type>
 	cofree_comodule<algebroid,degree_type> resolvor(comodule_generic<algebroid,degree_type> &X, matrix<ring> *inj, matrix<ring> *indj, matrix<ring> *quot, curtis_table<ring> *table, matrix<ring>*, std::vector<int> *gens, std::vector<int> *basis_order, std::iostream&);
 	 
-	//construct a pre-resolution together with the data for the co-generators
+	//construct a pre-resolution together with the data for the co-generators, continuing after the step res_start of a previous run if res_start>=0
+	//step_done is called when the data of a step are all written
+	template<typename degree_type>
+	void pre_resolution_tab(comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, std::vector<curtis_table<ring>*>& result, std::vector<std::vector<int>> &gens, matrix<ring>*, matrix<ring>*, matrix<ring>*, matrix<ring>*, std::string tablename = "table.tmp", std::vector<std::vector<int>> *basis_orders = NULL, string back_up_file_name = "", int res_start = -1, std::function<void(int)> step_done = std::function<void(int)>());
+	
+	//save the comodule reached after a step of a pre-resolution, with the generators found so far
+	template<typename degree_type>
+	void save_back_up(comodule_generic<algebroid,degree_type>& resolved, std::vector<std::vector<int>> const *gens, int step, string back_up_file_name);
+	//load the comodule reached after a step, false if there is no usable back-up
 	template<typename degree_type>
-	void pre_resolution_tab(comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, std::vector<curtis_table<ring>*>& result, std::vector<std::vector<int>> &gens, matrix<ring>*, matrix<ring>*, matrix<ring>*, matrix<ring>*, std::string tablename = "table.tmp", std::vector<std::vector<int>> *basis_orders = NULL);
+	bool load_back_up(comodule_generic<algebroid,degree_type>& resolved, std::vector<std::vector<int>> *gens, int step, string back_up_file_name);
 
 	//embed into a cofree comodule using a model
 	template<typename degree_type>
@@ -80,7 +96,7 @@ public:
 	
 	//pre-resolution with a model
 	template<typename degree_type, typename table_type>
-	void pre_resolution_modeled( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, string filename_table, curtis_table<table_type>* table, std::vector<std::vector<int>> &gens,std::function<vectors<matrix_index,ring>(vectors<matrix_index,table_type> const&)> transformer, matrix<ring> *inj, matrix<ring> *qut, matrix<ring> *indj, matrix<ring> *new_map, string back_up_file_name, int res_start=-1);
+	void pre_resolution_modeled( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, string filename_table, curtis_table<table_type>* table, std::vector<std::vector<int>> &gens,std::function<vectors<matrix_index,ring>(vectors<matrix_index,table_type> const&)> transformer, matrix<ring> *inj, matrix<ring> *qut, matrix<ring> *indj, matrix<ring> *new_map, string back_up_file_name, int res_start=-1, std::function<void(int)> step_done = std::function<void(int)>());
 	
 	//combine the generators data into one sigle file
 	template<typename degree_type>
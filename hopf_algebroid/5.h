@@ -4,7 +4,7 @@ template<typename degree_type>
 cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::resolvor(comodule_generic<algebroid,degree_type> &X, matrix<ring> *inj, matrix<ring> *indj, matrix<ring> *quot, curtis_table<ring> *table, matrix<ring> *new_map, std::vector<int> *gens, std::vector<int> *basis_order, std::iostream &tablefile){
 	std::cout << "embedding...\n" << std::flush;
 	//embed X into a cofree comodule F, with the injective map stored in inj, and the data for generators stored in gens
-	auto F = embed2cofree(&X,inj,table,gens,new_map,basis_order,tablefile);
+	auto F = embed2cofree_p(&X,inj,table,gens,new_map,basis_order,tablefile);
 
 	std::cout << inj->output();
 	std::cout << "Preparing Gausing...\n" << std::flush;
@@ -20,8 +20,11 @@ cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::resolvor(
 	std::cout << "Gausing...\n" << std::flush;
 
 	std::cout << indj->output();
-	//do Gaussan ellimination on indj
-	indj->gaussian(gs);
+	//do Gaussan ellimination on indj, the coeficients are in degree zero, so each internal degree is an independent block
+	std::vector<int> row_blocks;
+	for(int i=0; i<X.rank(); ++i)
+		row_blocks.push_back(cofree_comodule<algebroid,degree_type>::underlyingDeg(X.degree(i)));
+	indj->gaussian(gs, row_blocks);
 	
 	std::cout << "quotieting...\n" << std::flush;
 	//compute the quotient comodule, and replace X by this quotient
@@ -46,16 +49,35 @@ cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::resolvor(
 //result will be the container to store the intermediate curtis tables to be used as the model for the lifting to other Hopf algebroids
 //gens will be the data of the generators
 //inj and qut will be the containers for the imtermidiet matrices
+//if res_start>=0, the steps up to res_start are read from the files of a previous run with the same maximal degree, and the files are extended
 template<typename ring, typename algebroid>
 template<typename degree_type>
-void Hopf_Algebroid<ring,algebroid>::pre_resolution_tab( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, std::vector<curtis_table<ring>*>& result, std::vector<std::vector<int>> &gens, matrix<ring> *inj, matrix<ring> *indj, matrix<ring> *qut, matrix<ring> *new_map, std::string tablename, std::vector<std::vector<int>> *basis_orders){
+void Hopf_Algebroid<ring,algebroid>::pre_resolution_tab( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, std::vector<curtis_table<ring>*>& result, std::vector<std::vector<int>> &gens, matrix<ring> *inj, matrix<ring> *indj, matrix<ring> *qut, matrix<ring> *new_map, std::string tablename, std::vector<std::vector<int>> *basis_orders, string back_up_file_name, int res_start, std::function<void(int)> step_done){
+	gens.resize(resolution_length+1);
+	//load the partial resolution
+	if(res_start>=0){
+		if(res_start>=resolution_length)
+			std::cout << "the previous run reached the step " << res_start << "\n";
+		if(!load_back_up(resolved, &gens, res_start, back_up_file_name)){
+			std::cerr << "starting from scratch\n";
+			res_start = -1;
+		}
+		else{
+			//the tables of the steps already done
+			std::fstream tablefile(tablename, std::fstream::in | std::fstream::binary);
+			for(int i=0; i<=res_start && i<(int)result.size(); ++i)
+				result[i]->load(tablefile);
+		}
+	}
+	
+	auto mode = res_start>=0 ? std::fstream::app : std::fstream::out;
 	//open the file for the maps
-	std::fstream maps_file(filename_maps, std::fstream::out | std::fstream::binary);
+	std::fstream maps_file(filename_maps, mode | std::fstream::binary);
 	//open the file for the generators
-	std::fstream gens_file(filename_generators, std::fstream::out | std::fstream::binary);
+	std::fstream gens_file(filename_generators, mode | std::fstream::binary);
 	//file for tables
 	std::cout << tablename << "\n";
-	std::fstream tablefile(tablename, std::fstream::out | std::fstream::binary);
+	std::fstream tablefile(tablename, mode | std::fstream::binary);
 	//check the file
 	if(maps_file.is_open() && gens_file.is_open())
 		std::cout << "\nfiles succesfully opened\n";
@@ -64,10 +86,11 @@ void Hopf_Algebroid<ring,algebroid>::pre_resolution_tab( comodule_generic<algebr
 		std::cerr << "fail to open";
 	
 	//get the rank of the current comodule
-	int32_t M_rank = resolved.rank();  gens_file.write((char*)&M_rank, 4);
+	int32_t M_rank = resolved.rank();
+	if(res_start<0)
+		gens_file.write((char*)&M_rank, 4);
 	
-	gens.resize(resolution_length+1);
-	for(int i=0; i<=resolution_length; ++i){
+	for(int i=res_start+1; i<=resolution_length; ++i){
 		std::cout << "doing the " << i << "/" << resolution_length << "-th step\n" << std::flush;
 		//the injection to a cofree one
 		inj->clear();
@@ -92,5 +115,18 @@ void Hopf_Algebroid<ring,algebroid>::pre_resolution_tab( comodule_generic<algebr
 		
 		//update the rank of current comodule
 		M_rank = resolved.rank();  gens_file.write((char*)&M_rank, 4);
+		
+		maps_file.flush();
+		gens_file.flush();
+		tablefile.flush();
+		
+		//write the back-up file
+		if(back_up_file_name!="")
+			save_back_up(resolved, &gens, i, back_up_file_name);
+		if(step_done)
+			step_done(i);
+		//only the latest back-up is needed
+		if(back_up_file_name!="" && i>0)
+			std::remove((back_up_file_name + std::to_string(i-1)).c_str());
 	}
 }
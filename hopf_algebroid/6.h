@@ -38,9 +38,17 @@ cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::resolvor_
 //get the short exact sequences using a model
 template<typename ring, typename algebroid>
 template<typename degree_type, typename table_type>
-void Hopf_Algebroid<ring,algebroid>::pre_resolution_modeled( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, string filename_table, curtis_table<table_type> *table, std::vector<std::vector<int>> &gens,std::function<vectors<matrix_index,ring>(vectors<matrix_index,table_type> const&)> transformer, matrix<ring> *inj, matrix<ring> *qut, matrix<ring> *indj, matrix<ring> *new_map, string back_up_file_name, int res_start){
+void Hopf_Algebroid<ring,algebroid>::pre_resolution_modeled( comodule_generic<algebroid,degree_type>& resolved, string filename_maps, string filename_generators, int resolution_length, string filename_table, curtis_table<table_type> *table, std::vector<std::vector<int>> &gens,std::function<vectors<matrix_index,ring>(vectors<matrix_index,table_type> const&)> transformer, matrix<ring> *inj, matrix<ring> *qut, matrix<ring> *indj, matrix<ring> *new_map, string back_up_file_name, int res_start, std::function<void(int)> step_done){
 	maps_file_name = filename_maps;
 	
+	//load the partial resolution
+	if(res_start>=0 && !load_back_up(resolved, NULL, res_start, back_up_file_name)){
+		std::cerr << "starting from scratch\n";
+		res_start = -1;
+	}
+	if((int)gens.size() < resolution_length+2)
+		std::cerr << "the generators are only given for " << gens.size() << " steps\n";
+	
 	//open the files for the generators and maps
 	auto mode = res_start>=0 ? std::fstream::app : std::fstream::out;
 	std::fstream maps_file(filename_maps, mode | std::fstream::binary);
@@ -50,28 +58,24 @@ void Hopf_Algebroid<ring,algebroid>::pre_resolution_modeled( comodule_generic<al
 	if(!table_file.is_open())
 		std::cerr << "fail to open" << filename_table;
 	
-	int32_t M_rank;
-	//load the partial resolution
-	if(res_start>=0){
-		std::fstream back_file(back_up_file_name + std::to_string(res_start), std::fstream::in);
-		resolved.coaction_matrix->load(back_file);
-		back_file.close();
-	}
-	
 	//get the rank of the starting comodule
-	M_rank = resolved.rank();  
+	int32_t M_rank = resolved.rank();  
 	if(res_start<0){
 		gens_file0.write((char*)&M_rank, 4);
 	}
 	gens_file0.close();
 	maps_file.close();
 	
-	for(int i=0; i<=resolution_length; ++i) {
+	//skip the tables of the steps already done
+	for(int i=0; i<=res_start; ++i)
+		table->load(table_file);
+	
+	for(int i=res_start+1; i<=resolution_length; ++i) {
 		inj->clear();
 		qut->clear();
 		
-		//open the file for the maps
-		std::fstream maps_file(filename_maps + std::to_string(i), std::ios::out | std::fstream::binary);
+		//open the file for the maps, under a temporary name until the step is done
+		std::fstream maps_file(checkpoint::temporary(filename_maps + std::to_string(i)), std::ios::out | std::fstream::binary);
 		
 		//do resolution
 		std::cout << "ready to resolve" << i << "/" << resolution_length << "\n" << std::flush;
@@ -80,7 +84,7 @@ void Hopf_Algebroid<ring,algebroid>::pre_resolution_modeled( comodule_generic<al
 		auto F = resolvor_modeled(resolved, inj, qut, indj, new_map, table, &gens[i], &gens[i+1],transformer, maps_file);
 		
 		//save the data
-		std::fstream gens_file(filename_generators + std::to_string(i), std::ios::out | std::fstream::binary);
+		std::fstream gens_file(checkpoint::temporary(filename_generators + std::to_string(i)), std::ios::out | std::fstream::binary);
 
 		//save the quotient to the new comodule
 		inj->save(maps_file);
@@ -94,27 +98,81 @@ void Hopf_Algebroid<ring,algebroid>::pre_resolution_modeled( comodule_generic<al
 		
 		maps_file.close();
 		gens_file.close();
+		checkpoint::commit(filename_maps + std::to_string(i));
+		checkpoint::commit(filename_generators + std::to_string(i));
 		
-		//write the back-up file
+		//write the back-up file, and read the coactions back to compact the file of the coaction matrix
 		if(back_up_file_name!=""){
-			std::fstream back_file(back_up_file_name + std::to_string(i), std::fstream::out | std::fstream::binary);
-			
-			std::cout << back_file.is_open();
-		//	back_file.write((char*)&M_rank, 4);
-			resolved.coaction_matrix->save(back_file);
-			back_file.close();
-			
-			
-			back_file.open(back_up_file_name + std::to_string(i), std::fstream::in | std::fstream::binary);
-			
-			std::cout << back_file.is_open();
-		//	back_file.read((char*)&M_rank, 4);
-			resolved.coaction_matrix->load(back_file);
-			M_rank = resolved.coaction_matrix->rank;
-			back_file.close();
+			save_back_up(resolved, NULL, i, back_up_file_name);
+			load_back_up(resolved, NULL, i, back_up_file_name);
 		}
+		if(step_done)
+			step_done(i);
+		//only the latest back-up is needed
+		if(back_up_file_name!="" && i>0)
+			std::remove((back_up_file_name + std::to_string(i-1)).c_str());
+	}
+	
+}
+
+//save the comodule reached after a step. 4 bytes for the maximal degree, the base module, the coactions, then the generators of the steps up to this one
+template<typename ring, typename algebroid>
+template<typename degree_type>
+void Hopf_Algebroid<ring,algebroid>::save_back_up(comodule_generic<algebroid,degree_type>& resolved, std::vector<std::vector<int>> const *gens, int step, string back_up_file_name){
+	string filename = back_up_file_name + std::to_string(step);
+	std::fstream back_file(checkpoint::temporary(filename), std::fstream::out | std::fstream::binary);
+	if(!back_file.is_open())
+		std::cerr << "fail to open " << filename << "\n";
+	
+	int32_t deg = maxDeg;
+	back_file.write((char*)&deg, 4);
+	resolved.base_module.save(back_file);
+	resolved.coaction_matrix->save(back_file);
+	
+	int32_t sz = 0;
+	if(gens!=NULL)
+		sz = std::min((int)gens->size(), step+1);
+	back_file.write((char*)&sz, 4);
+	for(int i=0; i<sz; ++i){
+		int32_t ss = (*gens)[i].size();
+		back_file.write((char*)&ss, 4);
+		back_file.write((char*)(*gens)[i].data(), 4*ss);
+	}
+	back_file.close();
+	checkpoint::commit(filename);
+}
+
+//load the comodule reached after a step
+template<typename ring, typename algebroid>
+template<typename degree_type>
+bool Hopf_Algebroid<ring,algebroid>::load_back_up(comodule_generic<algebroid,degree_type>& resolved, std::vector<std::vector<int>> *gens, int step, string back_up_file_name){
+	std::fstream back_file(back_up_file_name + std::to_string(step), std::fstream::in | std::fstream::binary);
+	if(!back_file.is_open()){
+		std::cerr << "fail to open " << back_up_file_name + std::to_string(step) << "\n";
+		return false;
 	}
 	
+	//the positions in the cofree comodules depend on the maximal degree
+	int32_t deg;
+	back_file.read((char*)&deg, 4);
+	if(deg != (int32_t)maxDeg){
+		std::cerr << "the back-up is made for the maximal degree " << deg << ", not " << maxDeg << "\n";
+		return false;
+	}
+	resolved.base_module.load(back_file);
+	resolved.coaction_matrix->load(back_file);
+	
+	int32_t sz;
+	back_file.read((char*)&sz, 4);
+	for(int i=0; i<sz; ++i){
+		int32_t ss;
+		back_file.read((char*)&ss, 4);
+		std::vector<int> gs(ss);
+		back_file.read((char*)gs.data(), 4*ss);
+		if(gens!=NULL && i<(int)gens->size())
+			(*gens)[i] = gs;
+	}
+	return true;
 }
 
 //combing the data of generators into one file
@@ -127,7 +185,7 @@ void Hopf_Algebroid<ring,algebroid>::gens_file_combiner(string filename_generato
 	gens_file.read((char*)&M_rank,4);
 	gens_file.close();
 	
-	gens_file.open(filename_generators, std::ios::out | std::ios::trunc |std::ios::binary);
+	gens_file.open(checkpoint::temporary(filename_generators), std::ios::out | std::ios::trunc |std::ios::binary);
 	gens_file.write((char*)&M_rank,4);
 
 	for(int i=0; i<=resolution_length; ++i){
@@ -141,6 +199,8 @@ void Hopf_Algebroid<ring,algebroid>::gens_file_combiner(string filename_generato
 		F.save(gens_file);
 		gens_file.write((char*)&M_rank,4);
 	}
+	gens_file.close();
+	checkpoint::commit(filename_generators);
 }
 
 //load the data for generators
@@ -82,6 +82,112 @@ cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::embed2cof
 	return res;
 }
 
+//embed into a cofree comodule, reducing the rows of the same degree in parallel
+//the rows of a degree are first reduced against the table as it was at the beginning of the degree
+//then they are inserted in the original order, and a row is reduced again only if it meets an entry inserted in the same degree
+template<typename ring, typename algebroid>
+template<typename degree_type>
+cofree_comodule<algebroid,degree_type> Hopf_Algebroid<ring,algebroid>::embed2cofree_p(const CoModule<algebroid,degree_type> *X, matrix<ring> *inj, curtis_table<ring> *table, std::vector<int> *gens, matrix<ring> *new_map, std::vector<int> *basis_order, std::iostream &tablefile){
+	std::cout << X->rank() << std::flush;
+	std::vector<int> gns;
+	if(gens==NULL) gens = &gns;
+	
+	//initialize the map to a zero comodule
+	inj->set2zero(X->rank());
+	table->clear();
+	cofree_comodule<algebroid,degree_type> res;
+	//the set of basis
+	std::vector<int> bas;
+	for(int i=0; i<X->rank(); ++i)
+		bas.push_back(i);
+	
+	//sort the basis under degree
+	auto i_deg = [X] (int m){ 
+		return cofree_comodule<algebroid,degree_type>::underlyingDeg(X->degree(m)); };
+	std::cout << "sorting..." << std::flush;
+	std::stable_sort(bas.begin(),bas.end(),[i_deg](int m,int n) { return i_deg(m)<i_deg(n); });
+	
+	if(basis_order != NULL)
+		*basis_order = bas;
+	
+	unsigned j = 0;
+	while(j < bas.size()){
+		//the rows of the same degree
+		unsigned next = j;
+		while(next < bas.size() && i_deg(bas[next]) == i_deg(bas[j]))
+			++next;
+		std::cout << "\r" << next << "/" << X->rank() << std::flush;
+		
+		//reduce the rows against the current table
+		int snapshot_rank = res.rank();
+		std::vector<vectors<matrix_index, ring>> irows(next-j), scs(next-j);
+		std::vector<matrix_index> poses(next-j);
+		#pragma omp parallel for schedule(dynamic)
+		for(unsigned k=0; k<next-j; ++k){
+			int i = bas[j+k];
+			irows[k] = adjoint(X, *gens, res.position_of_gens, i, 0);
+			scs[k] = moduleOper->singleton(i);
+			poses[k] = table->simplify_to_led(snapshot_rank,X->rank(),irows[k],scs[k]);
+		}
+		
+		//insert the rows in order
+		std::set<matrix_index> inserted;
+		std::vector<int> new_gens;
+		std::vector<uint32_t> new_pos;
+		for(unsigned k=0; k<next-j; ++k){
+			int i = bas[j+k];
+			bool redo = false;
+			//the components on the generators added in this degree
+			if(!new_gens.empty()){
+				auto extra = adjoint(X, new_gens, new_pos, i, 0);
+				if(!moduleOper->isZero(extra)){
+					irows[k] = moduleOper->add(std::move(irows[k]), std::move(extra));
+					redo = true;
+				}
+			}
+			//the row meets an entry inserted after it was reduced
+			for(unsigned l=0; !redo && l<irows[k].dataArray.size(); ++l)
+				if(inserted.count(irows[k].dataArray[l].ind)) 
+					redo = true;
+			if(redo)
+				poses[k] = table->simplify_to_led(res.rank(),X->rank(),irows[k],scs[k]);
+			
+			if(poses[k]!=curtis_table<ring>::Boundary){
+				//this means the i-th row maps to a nontrivial element in the cofree one
+				table->insert(poses[k],i,irows[k],scs[k]);
+				inserted.insert(poses[k]);
+				//update inj
+				inj->insert(i,irows[k]);
+			}
+			else{
+				//we need a new generator
+				gens->push_back(i);
+				
+				//record the current rank
+				int old_rank = res.rank();
+				
+				//compute the new summand of the cofree comodule
+				cofree_comodule<algebroid,degree_type> new_sumd = adjoint(X,i,NULL,old_rank);
+
+				//add the new summand
+				res.direct_sum(new_sumd);
+				new_gens.push_back(i);
+				new_pos.push_back(res.position_of_gens.back());
+
+				//add new summand to the maps
+				auto irow = adjoint(X, *gens, res.position_of_gens, i, 0);
+				inj->insert(i,irow);
+				
+				//update the table
+				table->insert(old_rank,i,irow,scs[k]);
+				inserted.insert(old_rank);
+			}
+		}
+		j = next;
+	}
+	return res;
+}
+
 //embed into a cofree one, using a model
 template<typename ring, typename algebroid>
 template<typename degree_type>
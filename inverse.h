@@ -1,35 +1,101 @@
 //inverse.h
 #pragma once
 #include"matrices.h"
+#include<random>
 
 //find the partial inverse of an injective matrix using a table
+//the row of the leading term i of an entry is determined by the rows of the other terms in its cycle, so the rows are computed by levels of this dependence, and the rows of a level in parallel
 template<typename ring>
 void inverse(int source_rank, curtis_table<ring> &table, matrix<ring> &result, std::vector<int> &basis_order){
 	std::cout << "rank = " << source_rank << std::flush;
+	auto *ModOper = table.ModOper;
 	result.clear();
 
-	for(int j=0; j<source_rank; ++j){
-	//	int i = basis_order[j];
-		int i = source_rank - j - 1;
-		//compute the i-th row of the inverse matrix;
-		//those rows not in the table goes to zero
-		if(!table.is_member(i)){
-			result.insert(i, table.ModOper->zero());
-		//	std::cout << "\n" << i << std::flush;
-			continue;
+	//the entries, and the other terms in their cycles which are in the table
+	std::vector<bool> member(source_rank);
+	std::vector<typename curtis_table<ring>::entry> entries(source_rank);
+	std::vector<std::vector<matrix_index>> deps(source_rank);
+	for(int i=0; i<source_rank; ++i){
+		member[i] = table.is_member(i);
+		if(member[i])
+			entries[i] = table.search(i);
+	}
+	for(int i=0; i<source_rank; ++i)
+		if(member[i])
+			for(auto &tm : entries[i].full_cycle.dataArray)
+				if((int)tm.ind != i && (int)tm.ind < source_rank && member[tm.ind])
+					deps[i].push_back(tm.ind);
+
+	//the level of a row is one more than the levels of the rows it depends on
+	//a dependence back to a row in progress is dropped, and the row is taken to be zero there
+	std::vector<int> level(source_rank, -1);
+	std::vector<bool> in_progress(source_rank, false);
+	int cycles = 0;
+	for(int i=0; i<source_rank; ++i){
+		if(!member[i] || level[i]>=0) continue;
+		std::vector<std::pair<matrix_index,unsigned>> stack(1, std::make_pair(i,0u));
+		in_progress[i] = true;
+		while(!stack.empty()){
+			auto &top = stack.back();
+			matrix_index n = top.first;
+			if(top.second < deps[n].size()){
+				matrix_index d = deps[n][top.second++];
+				if(level[d]>=0) continue;
+				if(in_progress[d]){
+					++cycles;
+					continue;
+				}
+				in_progress[d] = true;
+				stack.push_back(std::make_pair(d,0u));
+				continue;
+			}
+			int lv = 0;
+			for(auto d : deps[n])
+				if(level[d]>=lv) lv = level[d]+1;
+			level[n] = lv;
+			in_progress[n] = false;
+			stack.pop_back();
+		}
+	}
+	if(cycles)
+		std::cerr << "\n" << cycles << " circular dependences in the table\n";
+
+	std::vector<std::vector<matrix_index>> levels;
+	for(int i=0; i<source_rank; ++i)
+		if(member[i]){
+			if(level[i] >= (int)levels.size())
+				levels.resize(level[i]+1);
+			levels[level[i]].push_back(i);
+		}
+
+	//the rows computed so far, those not in the table goes to zero
+	std::vector<vectors<matrix_index,ring>> rows(source_rank);
+	std::vector<bool> done(source_rank, false);
+	std::function<vectors<matrix_index,ring>(const ring&, const vectors<matrix_index,ring>&)> scalor_mult = [ModOper](const ring &r, const vectors<matrix_index,ring> &v){
+		return ModOper->scalor_mult(r, v); };
+	std::function<vectors<matrix_index,ring>(matrix_index)> find = [&rows, &done, ModOper](matrix_index n){
+		if(n < (matrix_index)rows.size() && done[n])
+			return rows[n];
+		return ModOper->zero(); };
+	AbGroupOp<vectors<matrix_index,ring>> *adop = ModOper;
+	for(auto &lv : levels){
+		#pragma omp parallel for schedule(dynamic)
+		for(unsigned k=0; k<lv.size(); ++k){
+			matrix_index i = lv[k];
+			auto &et = entries[i];
+			//the cycle c e_i + others maps to the tag, so e_i maps to (tag - image of others)/c
+			ring c = ModOper->component(i, et.full_cycle);
+			auto others = ModOper->add(et.full_cycle, ModOper->minus(ModOper->singleton(i, c)));
+			auto oim = ::maps_to(others, scalor_mult, adop, find);
+			rows[i] = ModOper->scalor_mult(ModOper->ringOper->inverse(c), ModOper->add(et.full_tag, ModOper->minus(oim)));
 		}
-		//otherwise use the table, such that the cycle of the i-th entry maps to the tag.
-		auto et = table.search(i);
-	//	std::cout <<"\n" << i << ";" << table.ModOper->output(et.full_cycle) << std::flush;
-		//find the other terms in the cycle
-		auto others = table.ModOper->minus(et.full_cycle);
-		others = table.ModOper->add(table.ModOper->singleton(i), others);
-		//find the image of the other terms
-		auto oim = result.maps_to(others);
-		//subtract this to the full_tag
-		auto row = table.ModOper->add(et.full_tag, oim);
-		result.insert(i, row);
+		for(auto i : lv)
+			done[i] = true;
 	}
+
+	std::function<vectors<matrix_index,ring>(int)> rw = [&rows](int i){
+		return std::move(rows[i]); };
+	result.construct(source_rank, rw);
 }
 
 //compute the inverse maps
@@ -103,10 +169,12 @@ std::vector<int> resolution(Hopf_Algebroid<ring, algebroid> &HA_oper, string fil
 	return res_rank;
 }
 
-//check the filename_splitting
+//check the splitting, on a random sample of the rows of the injective maps unless full is true
 template<typename ring>
-bool check_splitting(int resolution_length,matrix<ring> *inj, matrix<ring> *split, matrix<ring> *qut, string filename_maps, string filename_splitting){
+bool check_splitting(int resolution_length,matrix<ring> *inj, matrix<ring> *split, matrix<ring> *qut, string filename_maps, string filename_splitting, bool full = false, unsigned samples = 64){
 	std::fstream maps_file(filename_maps, std::ios::in | std::ios::binary);
+	auto *ModOper = matrix<ring>::moduleOper;
+	std::mt19937 rng(resolution_length);
 
 	bool res = true;
 	for(int i=0; i<resolution_length; ++i){
@@ -114,10 +182,30 @@ bool check_splitting(int resolution_length,matrix<ring> *inj, matrix<ring> *spli
 		split->load(split_file);
 		inj->load(maps_file);
 		qut->load(maps_file);
-		split->compose(inj, qut);
-		
-		inj->set2unit(qut->rank);
-		res = res && inj->equal(*qut);
+
+		//the rows to be checked
+		std::vector<int> rows;
+		if(full || inj->rank <= samples)
+			for(unsigned x=0; x<inj->rank; ++x)
+				rows.push_back(x);
+		else{
+			std::uniform_int_distribution<int> pick(0, inj->rank-1);
+			for(unsigned k=0; k<samples; ++k)
+				rows.push_back(pick(rng));
+		}
+
+		//the row x of the composition should be e_x
+		int failed = 0;
+		#pragma omp parallel for schedule(dynamic) reduction(+:failed)
+		for(unsigned k=0; k<rows.size(); ++k){
+			auto v = split->maps_to(inj->find(rows[k]));
+			if(!ModOper->isZero(ModOper->add(v, ModOper->minus(ModOper->singleton(rows[k])))))
+				++failed;
+		}
+		if(failed){
+			std::cerr << "\nthe splitting fails on " << failed << " of " << rows.size() << " rows at the step " << i << "\n";
+			res = false;
+		}
 	}
 	return res;
 }
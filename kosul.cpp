@@ -43,6 +43,8 @@ int main(int argc, char** argv){
 	
 	int maxdeg = std::atoi(argv[1]);
 	int length = std::atoi(argv[2]);
+	//check all the rows of the splitting, instead of a sample
+	bool full_check = argc>3 && string(argv[3]) == "full";
 	
 	SteenrodInit st(2,maxdeg, length, filename + "steenrod_coaction.data");
 	
@@ -66,7 +68,7 @@ int main(int argc, char** argv){
 	inverse(st.resolutionTables, res_rank, filename + "splitting", &st.indj, basis_orders);
 	
 	//check the splitting
-	if(check_splitting(length, &st.inj, &st.indj, &st.qut, filename + "maps", filename + "splitting"))
+	if(check_splitting(length, &st.inj, &st.indj, &st.qut, filename + "maps", filename + "splitting", full_check))
 		std::cout << "success";
 	else std::cout << "fail";
 	
@@ -1,117 +1,235 @@
 //lift.h
 #pragma once
 #include"hopf_algebroid.h"
+#include"matrices_mem.h"
 
 //compute the map to the co-generators F->cogen(F)
 template<typename ring, typename algebroid, typename  degree_type>
-vectors<matrix_index,ring> cogens_map(vectors<matrix_index,ring> &v, cofree_comodule<algebroid, degree_type> &F, ModuleOp<matrix_index, ring> &Module_oper){
-	std::function<matrix_index(matrix_index)> rule = [](matrix_index i){
-		matrix_index h = F.find_index(i);
-		if(h==cofree_comodule<algebroid, degree_type>::invalid_pos) 
-			return ModuleOp<matrix_index, ring>::invalid;
-		return h;
-	};
-	return Module_oper->filtered_reindex(rule, v);
+vectors<matrix_index,ring> cogens_map(vectors<matrix_index,ring> const &v, cofree_comodule<algebroid, degree_type> &F, ModuleOp<matrix_index, ring> *Module_oper){
+	std::function<matrix_index(matrix_index)> rule = [&F](matrix_index i){
+		return (matrix_index) F.find_index(i); };
+	matrix_index invalid = cofree_comodule<algebroid, degree_type>::invalid_pos;
+	return Module_oper->filtered_reindex(rule, v, invalid);
 }
 
-//compute the adjoind map of a map to cogenerators, return the i-th row
+//compute the adjoint map M->F of a map lg to the cogenerators of F, return the i-th row
 template<typename ring, typename algebroid, typename  degree_type>
-vectors<matrix_index,ring> adjoint(matrix<ring> *X, std::vector<uint32_t> const& pos, int i, Hopf_Algebroid<ring, algebroid> &HA_oper){
-	// psi(e_i)
-	auto ci = F.coaction(i);
-	// (1\otimes X) (psi (e_i))
-	std::function<vectors<matrix_index,algebroid>(const algebroid&, const vectors<matrix_index,ring>&)> right_mult = [&HA_oper] (const algebroid& A, const vectors<matrix_index,ring> &V){
-		return HA_oper.right_scalor_mult(A,V); };
-	auto av = X->maps_to(ci,right_mult, HA_oper.algebroidModuleOper); 
+vectors<matrix_index,ring> adjoint(const CoModule<algebroid, degree_type> *M, matrix<ring> *lg, cofree_comodule<algebroid, degree_type> const &F, int i, Hopf_Algebroid<ring, algebroid> &HA_oper){
+	// (1\otimes lg) (psi (e_i))
+	auto av = HA_oper.right_maps_to(M->coaction(i), lg, false);
 	//change to vector notation
 	vectors<matrix_index, ring> result;
-	for(int k=0; k<F.pos.size(); ++k){
-		algebroid kp = HA_oper->algebroidModuleOper->component(i);
-		auto nd = HA_oper->algebroid2vector(kp, pos[i]);
-		result.direct_sum(nd, 0);
-	}
+	for(auto &tm : av.dataArray)
+		result.direct_sum(HA_oper.algebroid2vector(tm.coeficient, F.position_of_gens[tm.ind]), 0);
 	return result;
 }
 
-//lift a map to its one-step resolution
+//make the quotient index for an injective map X->F, with data from a table
+template<typename ring>
+std::vector<matrix_index> make_quot_index(curtis_table<ring> *table, int Frank, int Xrank){
+	auto inj_ind = table->cycle_matrix(Xrank);
+	return matrix<ring>::quot_index(inj_ind, Frank).first;
+}
+
+//a splitting F->X of an injective map X->F of comodules. The rows of each internal degree are reduced against their own table, so the degrees are done in parallel
 template<typename ring, typename algebroid, typename degree_type>
-void lift_resolvor(cofree_comodule<algebroid, degree_type> &F3, matrix<ring> &inj2, matrix<ring> &qut2, matrix<ring> &spliter1, std::vector<matrix_index> &inv_ind1, matrix<ring> &starting_map, matrix<ring> &result, Hopf_Algebroid<ring, algebroid> &HA_oper, matrix<ring> *lg, matrix<ring> *cofree_map){
-	result.clear();
-	//compute the i-th term of the lifting F1->cogens(F3)
-	std::function<vectors<matrix_index, ring>(int i)> cogens_lifting = [&spliter1, &starting_map, &inj2, &HA_oper, &F3](int i){
-		//get the i-th row of the spliting map 
-		auto spv = spliter1.find(i);
-		//the image in X2
-		auto pva = starting_map.maps_to(spv);
-		//find the image in F3
-		auto pb = inj2.maps_to(pva);
-		//find the map to the cogenerators
-		return cogens_map(pb, F3, HA_oper);
+void split_injection(const CoModule<algebroid, degree_type> *X, cofree_comodule<algebroid, degree_type> const &F, matrix<ring> *inj, matrix<ring> *result){
+	typedef cofree_comodule<algebroid, degree_type> cofree;
+	auto *ModOper = matrix<ring>::moduleOper;
+	auto *ringOper = ModOper->ringOper;
+
+	//the rows of X in each degree, and a table for each degree
+	std::map<int, std::vector<int>> rows;
+	for(int i=0; i<X->rank(); ++i)
+		rows[cofree::underlyingDeg(X->degree(i))].push_back(i);
+	std::vector<int> degs;
+	std::map<int, curtis_table_mem<ring>> tables;
+	for(auto &rw : rows){
+		degs.push_back(rw.first);
+		tables[rw.first];
 	}
-	lg->construct(spliter1.rank, cogens_lifting);
-	
-	if(cofree_map!=NULL){
-		std::function<vectors<matrix_index, ring>(int i)> F1F3 = []{
-			return adjoint(lg, F3.position_of_gens, i, HA_oper); };
-		cofree_map->construct(lg->rank, F1F3);
+
+	//reduce the images of the rows, keeping the preimage of the reduced image as the tag
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned k=0; k<degs.size(); ++k){
+		auto &table = tables.at(degs[k]);
+		for(int i : rows.at(degs[k])){
+			auto row = inj->find(i);
+			if(ModOper->isZero(row)){
+				std::cerr << "the map is not injective at " << i << "\n";
+				continue;
+			}
+			std::vector<ring> x = row.toDense(F.rank());
+			std::vector<ring> htpy = ModOper->singleton(i).toDense(X->rank());
+			auto pos = table.symplify_to_led(x, row.dataArray[0].ind, &htpy);
+			if(pos == curtis_table<ring>::Boundary){
+				std::cerr << "the map is not injective at " << i << "\n";
+				continue;
+			}
+			vectors<matrix_index,ring> cyc, tag;
+			cyc.deDense(x, ringOper, pos);
+			tag.deDense(htpy, ringOper, 0);
+			table.insert(pos, i, cyc, tag);
+		}
 	}
-	
-	//compute the i-th term of the map F1->M2
-	std::function<vectors<matrix_index, ring>(int i)> F1M2 = [&cogens_map, &qut2, &inv_ind1](int i){
-		auto F1F3 = adjoint(lg, F3.position_of_gens, inv_ind1[i], HA_oper);
-		return qut2.maps_to(F1F3); 
+
+	//e_j = y + inj(h) with y reduced, which is in the complement of the image, so e_j maps to h
+	std::function<vectors<matrix_index,ring>(int)> split_row = [&](int j){
+		auto it = tables.find(cofree::underlyingDeg(F.degree(j)));
+		if(it == tables.end())
+			return ModOper->zero();
+		std::vector<ring> x = ModOper->singleton(j).toDense(F.rank());
+		std::vector<ring> htpy(X->rank(), ringOper->zero());
+		it->second.symplify_to_led(x, j, &htpy);
+		vectors<matrix_index,ring> h;
+		h.deDense(htpy, ringOper, 0);
+		return ModOper->minus(h);
 	};
-	
-	//construct the matrix
-	result.construct(inv_ind1.size(), F1M2);
+	result->construct_parallel(F.rank(), split_row);
 }
 
-//lift a map between resolutions
-template<typename ring, typename algebroid>
-void resolution_lift(int resolution_length, matrix<ring> *current_map, string splitfile1, string gensfile2, string mapsfile2, std::vector<std::vector<matrix_index>> &inv_ind1, matrix<ring> *next_map, Hopf_Algebroid<ring,algebroid> &HA_oper, string liftedfile, matrix<ring> *inj2, matrix<ring> *qut2, matrix<ring> *spliter1, matrix<ring> *liftedmap, std::iostream *cofree_map_file = NULL, matrix<ring> *cofree_map){
-	//generators for the resolution of the second comodule
-	std::fstream gens_file2(gensfile2, std::ios::in | std::ios::binary);
-	//maps in the resolution of the second comodule
-	std::fstream maps_file2(mapsfile2, std::ios::in | std::ios::binary);
-	for(int i=0; i<resolution_length; ++i){
-		//file for the splitting of the resolution of first comodule
-		std::fstream split_file1(splitfile1 + std::to_string(i), std::ios::in | std::ios::binary);
-		//file for the lifted maps
-		std::fstream lift_file(liftedfile + std::to_string(i), std::ios::out | std::ios::binary);
-		
-		//read the rank of second resolution
-		int32_t M_rank;
-		gens_file2.read((char*)&M_rank, 4);
-		
-		//read the generators for second resolution
-		cofree_comodule<algebroid,degree_type> F3;
-		F3.load(gens_file);
-		
-		//load the maps
-		inj2->clear();
-		qut2->clear();
-		inj2->load(maps_file);
-		qut2->load(maps_file);
-		
-		//load the spliting map for the first resolution
-		spliter1->load(split_file1);
-		
-		//lift the map
-		lift_resolvor(F3, *inj2, *qut2, *spliter1, inv_ind1[i], *current_map, *next_map, HA_oper, liftedmap, cofree_map);
-		
-		//save the maps
-		liftedmap->save(lift_file);
-		if(cofree_map_file!=NULL)
-			cofree_map->save(*cofree_map_file);
-		
-		//renew the comodule maps
-		current_map->construct(*next_map);
+//a step X_i->F_i->X_{i+1} of a minimal resolution, with X_i recovered as a quotient of F_{i-1}
+template<typename ring, typename algebroid, typename degree_type>
+class resolution_term{
+public:
+	//the coaction of X_i
+	matrix_mem<algebroid> coaction;
+	comodule_generic<algebroid, degree_type> X;
+	//the cofree comodule F_i
+	cofree_comodule<algebroid, degree_type> F;
+	//the injection X_i->F_i as a map of comodules, and the quotient F_i->X_{i+1}
+	matrix_mem<ring> inj, qut;
+	//a splitting F_i->X_i of the injection
+	matrix_mem<ring> split;
+	//the elements of X_i giving the co-generators of F_i
+	std::vector<int> gens;
+	//the elements of F_i lifting the basis of X_{i+1}
+	std::vector<matrix_index> section;
+
+	resolution_term() : X(&coaction) {}
+};
+
+//the data of a minimal resolution, loaded from the files of a run
+template<typename ring, typename algebroid, typename degree_type>
+class resolution_data{
+public:
+	std::vector<resolution_term<ring,algebroid,degree_type>> terms;
+
+	resolution_data(int resolution_length) : terms(resolution_length) {}
+
+	//load the generators, the maps, the tables and the generators data, saved with the prefix filename
+	//the saved injections are reduced by the tables, so they are recomputed from the quotient coactions, and then split
+	void load(Hopf_Algebroid<ring,algebroid> &HA_oper, string filename){
+		std::fstream gens_file(filename + "gens", std::ios::in | std::ios::binary);
+		std::fstream maps_file(filename + "maps", std::ios::in | std::ios::binary);
+		std::fstream tables_file(filename + "ResTables", std::ios::in | std::ios::binary);
+		std::fstream gens_data(filename + "gens_data", std::ios::in | std::ios::binary);
+		if(!gens_file.is_open() || !maps_file.is_open() || !tables_file.is_open() || !gens_data.is_open()){
+			std::cerr << "failed to open the files of the resolution " << filename << "\n";
+			return;
+		}
+
+		int32_t M_rank, sz;
+		gens_file.read((char*)&M_rank, 4);
+		gens_data.read((char*)&sz, 4);
+		if(sz < (int)terms.size()){
+			std::cerr << "the resolution has only " << sz << " steps\n";
+			terms.resize(sz);
+		}
+
+		matrix_mem<ring> saved_inj;
+		curtis_table_mem<ring> table;
+		for(unsigned i=0; i<terms.size(); ++i){
+			auto &T = terms[i];
+			std::cout << "\rloading step " << i << std::flush;
+			T.F.load(gens_file);
+			gens_file.read((char*)&M_rank, 4);
+			saved_inj.load(maps_file);
+			T.qut.load(maps_file);
+			table.load(tables_file);
+			T.section = make_quot_index(&table, T.F.rank(), saved_inj.rank);
+
+			int32_t ss;
+			gens_data.read((char*)&ss, 4);
+			T.gens.resize(ss);
+			for(int j=0; j<ss; ++j)
+				gens_data.read((char*)&T.gens[j], 4);
+
+			//the comodule X_i
+			if(i==0)
+				HA_oper.set_to_trivial(T.X, (degree_type) 0);
+			else
+				HA_oper.quotient_p(&terms[i-1].F, &terms[i-1].qut, terms[i-1].section, T.X);
+
+			//the injection and its splitting
+			std::function<vectors<matrix_index,ring>(int)> inj_row = [&HA_oper, &T](int x){
+				return HA_oper.adjoint(&T.X, T.gens, T.F.position_of_gens, x); };
+			T.inj.construct_parallel(T.X.rank(), inj_row);
+			split_injection(&T.X, T.F, &T.inj, &T.split);
+		}
+		std::cout << "\n" << std::flush;
 	}
+};
+
+//lift a map X_i->X'_{i+s} of internal degree shift to F_i->F'_{i+s}, given by its map lg to the co-generators of F'_{i+s}
+//if result is not NULL, also compute the induced map on the quotients X_{i+1}->X'_{i+s+1}
+template<typename ring, typename algebroid, typename degree_type>
+void lift_resolvor(resolution_term<ring,algebroid,degree_type> &source, resolution_term<ring,algebroid,degree_type> &target, matrix<ring> &starting_map, int shift, matrix<ring> &lg, matrix<ring> *result, Hopf_Algebroid<ring, algebroid> &HA_oper){
+	typedef cofree_comodule<algebroid, degree_type> cofree;
+	int max_deg = HA_oper.maxDeg;
+	auto *ModOper = matrix<ring>::moduleOper;
+
+	//the i-th row of F_i->cogens(F'_{i+s}), through the splitting F_i->X_i
+	std::function<vectors<matrix_index,ring>(int)> cogens_lifting = [&](int i){
+		if(cofree::underlyingDeg(source.F.degree(i)) + shift > max_deg)
+			return ModOper->zero();
+		auto pva = starting_map.maps_to(source.split.find(i));
+		auto pb = target.inj.maps_to(pva);
+		return cogens_map(pb, target.F, ModOper);
+	};
+	lg.construct(source.F.rank(), cogens_lifting);
+
+	if(result == NULL)
+		return;
+	//the image of X_{i+1} is the quotient of the image of its section in F'_{i+s}
+	std::function<vectors<matrix_index,ring>(int)> F1M2 = [&](int z){
+		int q = source.section[z];
+		if(cofree::underlyingDeg(source.F.degree(q)) + shift > max_deg)
+			return ModOper->zero();
+		return target.qut.maps_to(adjoint(&source.F, &lg, target.F, q, HA_oper));
+	};
+	result->construct(source.section.size(), F1M2);
 }
 
-//make the quotient index for an injective map X->F, with data from a table
-template<typename ring>
-std::vector<matrix_index> make_quot_index(curtis_table<ring> *table, int Frank, int Xrank){
-	auto inj_ind = table->cycle_matrix(Xrank());
-	auto quot_inds = matrix<ring>::quot_index(inj_ind, Frank);
+//lift the cocycle given by the co-generator g of F_s to a chain map, returning its products with the co-generators of F_j for all the j that fit
+//the j-th entry of the result are the images of the co-generators of F_j, as vectors over the co-generators of F_{s+j}
+template<typename ring, typename algebroid, typename degree_type>
+std::vector<std::vector<vectors<matrix_index,ring>>> resolution_lift(resolution_data<ring,algebroid,degree_type> &R, int s, int g, Hopf_Algebroid<ring,algebroid> &HA_oper){
+	typedef cofree_comodule<algebroid, degree_type> cofree;
+	auto &Fs = R.terms[s].F;
+	int shift = cofree::underlyingDeg(Fs.generators.degree[g]);
+	std::vector<std::vector<vectors<matrix_index,ring>>> products;
+
+	//the primitive of X_s whose image is the co-generator
+	auto y = R.terms[s].split.find(Fs.position_of_gens[g]);
+	if(!matrix<ring>::moduleOper->isZero(matrix<ring>::moduleOper->add(R.terms[s].inj.maps_to(y), matrix<ring>::moduleOper->minus(matrix<ring>::moduleOper->singleton(Fs.position_of_gens[g]))))){
+		std::cerr << "the co-generator " << s << "-" << g << " is not in the image of X_" << s << "\n";
+		return products;
+	}
+
+	//the map X_0->X_s
+	matrix_mem<ring> current_map, next_map, lg;
+	current_map.construct(1, [&y](int){ return y; });
+	for(unsigned j=0; j+s<R.terms.size(); ++j){
+		auto &source = R.terms[j];
+		bool last = j+s+1 == R.terms.size();
+		lift_resolvor(source, R.terms[j+s], current_map, shift, lg, last ? NULL : &next_map, HA_oper);
+		//the products with the co-generators of F_j
+		products.emplace_back();
+		for(unsigned h=0; h<source.F.position_of_gens.size(); ++h)
+			products.back().push_back(lg.find(source.F.position_of_gens[h]));
+		if(!last)
+			current_map.construct(&next_map);
+	}
+	return products;
 }
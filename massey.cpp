@@ -0,0 +1,171 @@
+//massey.cpp
+#include"massey.h"
+
+//constructor
+massey::massey(BP_Op *BP_oper, multiplication *mult, BPBP const &x0, BP const &b0, int d, string nm){
+	BPoper = BP_oper;
+	multp = mult;
+	x = x0;
+	b = b0;
+	deg = d;
+	name = nm;
+}
+
+//check that 3x = etaR(b)-etaL(b)
+bool massey::valid(){
+	auto &Op = BPoper->BPBP_opers;
+	auto db = Op.add(Op.minus(BPoper->etaL(b)), BPoper->etaR(b));
+	auto x3 = Op.scalor_mult(BPoper->monomial(0, BPoper->Z3_oper->unit(3)), x);
+	return Op.isZero(Op.add(db, Op.minus(x3)));
+}
+
+//compute the brackets of the requested cycles in a term
+void massey::brackets(std::vector<cycle_name> const &requested, matrix_mem<Z3> *mm, primitive_data &P, algNov_table &prev_table, algNov_table &cur_table, algNov_table &next_table, int k, int pric){
+	auto *Modop = cur_table.Modop;
+	auto three = Modop->ringOper->unit(3);
+
+	//the degrees of the requested cycles, and the cycles of the previous term in these degrees
+	std::vector<int> degs(requested.size());
+	std::set<int> req_degs;
+	for(unsigned j=0; j<requested.size(); ++j){
+		degs[j] = cur_table.degree(requested[j]);
+		req_degs.insert(degs[j]);
+	}
+	std::vector<SS_entry<cycle_name,Z3> const*> ys;
+	for(auto &tm : prev_table){
+		if(!prev_table.valid(tm.cycle) || prev_table.tagged(tm)) continue;
+		if(req_degs.count(prev_table.degree(tm.cycle)))
+			ys.push_back(&tm);
+	}
+
+	//the products y x, which span the indeterminacy
+	multiplication_table<cycle_name> ind(ys.size());
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned j=0; j<ys.size(); ++j){
+		auto v = mm->maps_to(ys[j]->full_cycle);
+		ind[j] = {ys[j]->cycle, cur_table.combine_cycles(cur_table.name_of_cycle(v,&next_table,pric))};
+	}
+	std::unordered_map<int, multiplication_table<cycle_name>> ind_of_deg;
+	for(unsigned j=0; j<ys.size(); ++j)
+		if(!ind[j].multiplied_names.second.empty())
+			ind_of_deg[prev_table.degree(ys[j]->cycle)].push_back(ind[j]);
+
+	std::vector<massey_entry> res(requested.size());
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned j=0; j<requested.size(); ++j){
+		auto &et = res[j];
+		et.original_name = requested[j];
+		et.defined = false;
+		auto it = cur_table.cycle_index.find(requested[j]);
+		if(it == cur_table.cycle_index.end() || cur_table.tagged(cur_table[it->second]))
+			continue;
+		auto &c = cur_table[it->second].full_cycle;
+
+		//find w with d(w) = 3c, using the tags of the table
+		auto v = Modop->scalor_mult(three, c);
+		auto htpy = Modop->zero();
+		if(cur_table.simplify(v, htpy, pric) != SS_table<cycle_name,Z3>::Boundary)
+			continue;
+		et.defined = true;
+
+		//the term b c, by multiplying the coeficients of the primitives
+		vectors<matrix_index,BP> bc;
+		for(auto &tm : c.dataArray){
+			auto &pm = P[tm.ind];
+			auto r = BPoper->multiply(b, BPoper->monomial(pm.coeficient, tm.coeficient));
+			//the primitives of a generator are consecutive
+			if(bc.size() && bc.dataArray.back().ind == pm.gen_pos)
+				bc.dataArray.back().coeficient = BPoper->add(bc.dataArray.back().coeficient, r);
+			else
+				bc.push(vectors<matrix_index,BP>::term(pm.gen_pos, std::move(r)));
+		}
+
+		//the representative w x + b c, where htpy = -w
+		auto rep = Modop->add(Modop->minus(mm->maps_to(htpy)), P.expand(bc));
+		et.bracket_names = cur_table.combine_cycles(cur_table.name_of_cycle(rep,&next_table,pric));
+		et.indeterminacy = ind_of_deg.count(degs[j]) ? ind_of_deg.at(degs[j]) : multiplication_table<cycle_name>();
+	}
+
+	for(auto &et : res)
+		cache[k].emplace(et.original_name, std::move(et));
+}
+
+//compute <c,3,x> for the requested cycles of each homological degree
+std::vector<std::vector<massey_entry>> massey::brackets(std::vector<std::vector<cycle_name>> const &requested, int max_deg, int resolution_length, std::vector<FreeBPCoMod>& generators, string maps_filename, BPComplex& Cm, algNov_tables& Tb, matrix<BP> *mp, matrix<Z3> *mm, int pric, bool fixedpric){
+	if(!valid()){
+		std::cerr << "3" << name << " is not etaR(b)-etaL(b)\n";
+		return std::vector<std::vector<massey_entry>>();
+	}
+	//make the multiplication table on BPBP
+	matrix_mem<BP> mult;
+	multp->make_eta_R_multiplier(x, &mult, deg);
+	cache.resize(resolution_length);
+
+	std::vector<std::vector<massey_entry>> result(resolution_length);
+	//open the files of the maps
+	std::fstream maps_file(maps_filename, std::ios::in | std::ios::binary);
+	//the brackets of the cycles of the i-th term use the multiplication from the (i-1)-th term
+	for(int i=1;i<resolution_length-1;++i){
+		//load the maps in the resolution
+		mp->load(maps_file);
+		int cpric = fixedpric ? pric : pric-i;
+		auto &cur_table = *Tb.tables[i];
+
+		//the requested cycles, or all the cycles in the range
+		std::vector<cycle_name> names;
+		if(i < (int)requested.size() && !requested[i].empty())
+			names = requested[i];
+		else
+			for(auto &tm : cur_table)
+				if(cur_table.valid(tm.cycle) && !cur_table.tagged(tm) && cur_table.filtration(tm.cycle) < cpric && cur_table.degree(tm.cycle) + deg <= max_deg)
+					names.push_back(tm.cycle);
+
+		//compute those not known yet
+		std::vector<cycle_name> todo;
+		for(auto &nm : names)
+			if(!cache[i].count(nm))
+				todo.push_back(nm);
+		if(!todo.empty()){
+			std::cout << "\n" << i << ":" << todo.size() << " brackets" << std::flush;
+			//compute the matrix for the multiplication
+			mm->clear();
+			multp->multily_matrix(max_deg - deg, &mult, mp, &generators[i-1], &Cm.Prims[i], mm);
+			//the rows are read in parallel, so the matrix is copied to the memory once
+			matrix_mem<Z3> mult_matrix;
+			mult_matrix.construct(mm);
+			brackets(todo, &mult_matrix, Cm.Prims[i], *Tb.tables[i-1], cur_table, *Tb.tables[i+1], i, cpric);
+		}
+
+		for(auto &nm : names)
+			result[i].push_back(cache[i].at(nm));
+	}
+	return result;
+}
+
+//output the brackets
+string massey::output(std::vector<std::vector<massey_entry>> const &MTs, int pric){
+	algNov_table Tb;
+	string res;
+	for(unsigned i=0;i<MTs.size();++i){
+		for(auto &et : MTs[i]){
+			//skip those out of range, and those not defined
+			if(!et.defined || Tb.filtration(et.original_name) >= pric-(int)i) continue;
+			res += "<" + Tb.output(et.original_name,i) + ",3," + name + ">\t->\t";
+			for(auto sm: et.bracket_names.second)
+				res+= Tb.output(sm,i)+"+";
+			res+= "o";
+			//the indeterminacy
+			if(!et.indeterminacy.empty()){
+				res+= "\tmod\t";
+				for(auto &tm : et.indeterminacy){
+					res+= Tb.output(tm.original_name,i-1) + name + "=";
+					for(auto sm: tm.multiplied_names.second)
+						res+= Tb.output(sm,i)+"+";
+					res+= "o ";
+				}
+			}
+			res+= "\n";
+		}
+	}
+	return res;
+}
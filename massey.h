@@ -0,0 +1,53 @@
+//massey.h
+#pragma once
+#include"multiplication.h"
+#include<unordered_map>
+
+//the Massey product <c,3,x> of a cycle c with 3c a boundary, for a multiplier x with 3x = etaR(b)-etaL(b)
+//if 3c = d(w), then w x + b c is primitive, and its image under the resolution gives a cycle representing <c,3,x>
+struct massey_entry{
+	//the name of the cycle c
+	cycle_name original_name;
+	//false if 3c is not a boundary, so that the bracket is not defined
+	bool defined;
+	//the names of the representative of the bracket, as boundaries and cycles
+	std::pair<std::vector<cycle_name>, std::vector<cycle_name>> bracket_names;
+	//the products y x, for the cycles y in the degree of c, which span the indeterminacy
+	multiplication_table<cycle_name> indeterminacy;
+};
+
+//the class for the Massey products <c,3,x> on an algebraic Novikov table
+class massey{
+	//operators for BP
+	BP_Op *BPoper;
+	//the multiplicative structure
+	multiplication *multp;
+
+	//the multiplier x, the element b with 3x = etaR(b)-etaL(b), and the degree of x
+	BPBP x;
+	BP b;
+	int deg;
+
+	//the brackets already computed, for each homological degree
+	std::vector<std::unordered_map<cycle_name, massey_entry>> cache;
+
+	//compute the brackets of the requested cycles in a term, using the multiplication matrix from the previous term, whose rows are read in parallel
+	void brackets(std::vector<cycle_name> const &requested, matrix_mem<Z3>*, primitive_data &P, algNov_table &prev_table, algNov_table &cur_table, algNov_table &next_table, int k, int pric);
+
+public:
+	//the name of the multiplier in the output
+	string name;
+
+	//constructor
+	massey(BP_Op*, multiplication*, BPBP const &x, BP const &b, int deg, string name);
+
+	//check that 3x = etaR(b)-etaL(b)
+	bool valid();
+
+	//compute <c,3,x> for the requested cycles of each homological degree, or all the cycles of a degree if none is requested there
+	//the brackets of the cycles in a term are computed in parallel, and the results are kept for later requests
+	std::vector<std::vector<massey_entry>> brackets(std::vector<std::vector<cycle_name>> const &requested, int max_deg, int resolution_length, std::vector<FreeBPCoMod>&, string, BPComplex&, algNov_tables&, matrix<BP>*, matrix<Z3>*, int pric, bool fixedpric=false);
+
+	//output the brackets
+	string output(std::vector<std::vector<massey_entry>> const&, int pric);
+};
@@ -23,6 +23,9 @@ public:
 	//update all rows
 	virtual void update_all(std::function<void(vectors<matrix_index,R>&,matrix_index)>)=0;
 	
+	//prepare the rows to be read by many threads at once, until the matrix is changed
+	virtual void share_rows(){}
+	
 	//filter the columns
 	void filter(std::function<bool(matrix_index)> rule){
 		std::function<void(vectors<matrix_index,R>&,matrix_index)> action = [this, &rule] (vectors<matrix_index,R>& x, matrix_index){ 
@@ -123,6 +126,10 @@ public:
 	//Gaussian ellimination
 	virtual void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols)=0;
 	
+	//Gaussian ellimination on independent blocks of rows, the pivots of a block only meet the rows in the same block
+	virtual void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::vector<int> const &row_blocks){
+		gaussian(row_cols); }
+	
 	//delete some columns and then do Gaussion
 	virtual void del_and_gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::set<int> const &to_del)=0;
 	
@@ -33,9 +33,10 @@ void matrix<R>::make_quotient(std::vector<matrix_index> const &inverse_ind, std:
 		newTerm = moduleOper->add(newTerm, moduleOper->singleton(inj_index[i]));
 		std::cout << i << " " << std::flush;
 		
+		//the quotient indices are increasing, and the remaining terms of the row all lie in the quotient
 		std::function<matrix_index(matrix_index)>  rule = [&quot_ind] (matrix_index n){ 
 			return quot_ind.at(n); };
-		result -> insert(inj_index.at(i), moduleOper -> re_index(rule, newTerm));
+		result -> insert(inj_index.at(i), moduleOper -> re_index_monotone(rule, std::move(newTerm)));
 	}
 	//on the remaining indices are identities 
 	for(unsigned i=0; i<inverse_ind.size(); i++)
@@ -31,40 +31,41 @@ public:
 	static constexpr matrix_index Boundary = -1;
 	
 	//simplify a vector using the table, preserving the homotopy
+	//the positions are scanned in a loop, so that it is safe to run on the small stacks of the worker threads
 	matrix_index symplify_to_led(std::vector<ring> &x, matrix_index start, std::vector<ring> *homotopy=NULL){
-		//zero is a boundary
-		if(start >= x.size()) return Boundary;
-		
-		//find the current leading term
- 		if(ModOper->ringOper->isZero(x[start]))
-			return symplify_to_led(x, start+1, homotopy);
-		
-		//when the leading term is in the table
-		if(is_member(start)){
-			//fint the leading coeficient
-			ring cp = ModOper->ringOper->minus(x[start]);
-			//find the entry
-			entry *etr;
-			etr = search_ref(start);
-
-			//EB: We will later do x = x + cp * etr and we want the coefficient of the leading term to be zero in this, so cp = -x[start] / etr->full_cycle[start].
-			ring inv = ModOper->ringOper->inverse(ModOper->component(start, etr->full_cycle));
-			cp = ModOper->ringOper->multiply(cp, inv);
-		//	entry ks = search(start);
-		//	etr = &ks;
-			//take away the term in the table from x
-			etr->full_cycle.add2Dense(cp, x, ModOper->ringOper);
+		for(; start < x.size(); ++start){
+			//find the current leading term
+ 			if(ModOper->ringOper->isZero(x[start]))
+				continue;
 			
-			if(homotopy!=NULL)
-				etr->full_tag.add2Dense(cp, *homotopy, ModOper->ringOper);
+			//when the leading term is in the table
+			if(is_member(start)){
+				//fint the leading coeficient
+				ring cp = ModOper->ringOper->minus(x[start]);
+				//find the entry
+				entry *etr;
+				etr = search_ref(start);
 
-			//take care of the next leading term
-			return symplify_to_led(x,start+1,homotopy);
+				//EB: We will later do x = x + cp * etr and we want the coefficient of the leading term to be zero in this, so cp = -x[start] / etr->full_cycle[start].
+				ring inv = ModOper->ringOper->inverse(ModOper->component(start, etr->full_cycle));
+				cp = ModOper->ringOper->multiply(cp, inv);
+			//	entry ks = search(start);
+			//	etr = &ks;
+				//take away the term in the table from x
+				etr->full_cycle.add2Dense(cp, x, ModOper->ringOper);
+				
+				if(homotopy!=NULL)
+					etr->full_tag.add2Dense(cp, *homotopy, ModOper->ringOper);
+
+				//take care of the next leading term
+				continue;
+			}
+			
+			//the leading term is invertible, gives a non trivial cycle
+			if(ModOper->ringOper->invertible(x[start])) return start;
 		}
-		
-		//the leading term is invertible, gives a non trivial cycle
-		if(ModOper->ringOper->invertible(x[start])) return start;
-		else return symplify_to_led(x,start+1,homotopy);
+		//zero is a boundary
+		return Boundary;
 	}
 	
 private:
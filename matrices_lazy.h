@@ -0,0 +1,194 @@
+//matrices_lazy.h
+#pragma once
+#include"matrices.h"
+#include"matrices_mem.h"
+#include"matrices_mmap.h"
+#include"checkpoint.h"
+#include<fstream>
+#include<mutex>
+
+//matrix whose rows are computed on first use by a rule
+//a row is saved to the temporary file of the table once all the rows before it are known, so the file is the table saved row by row, and the rows already saved are read back by a later run
+//the jobs append to the temporary file under a lock, and the one saving the last row renames it into place
+//a complete table is mapped to memory instead, and shared with the other jobs
+template<typename ring>
+class matrix_lazy : public matrix<ring>{
+	//the rule computing the rows, which may call find for other rows
+	std::function<vectors<matrix_index,ring>(matrix_index)> make_row;
+
+	//the temporary file, and the positions of the rows saved in it
+	string filename;
+	mutable std::fstream file;
+	mutable std::vector<std::streampos> datapos;
+	mutable std::streampos end;
+	//the lock on the temporary file, and the file opened, 0 if it is not opened yet
+	//the rows are saved only while the file opened is still the temporary file
+	mutable file_lock lock;
+	mutable ino_t file_id;
+	mutable bool saving;
+
+	//the complete table mapped to memory
+	matrix_mmap<ring> mapped;
+	bool complete;
+
+	//the rows computed but not saved yet
+	mutable std::map<matrix_index, vectors<matrix_index,ring>> pending;
+	mutable std::mutex locker;
+
+	//read the rows saved after the known ones, a row cut off by an interrupted run is computed again
+	void read_rows() const{
+		file.clear();
+		file.seekg(end);
+		while(datapos.size() < this->rank && file.peek() != EOF){
+			auto pos = file.tellg();
+			this->moduleOper->load(file);
+			if(file.fail())
+				break;
+			datapos.push_back(pos);
+			end = file.tellg();
+		}
+		file.clear();
+	}
+
+	//save the rows following the saved ones, after the rows saved by the other jobs
+	//if another job holds the lock, the rows are saved next time
+	void flush() const{
+		if(!saving || !lock.acquire(false))
+			return;
+		//the file was locked by another job when the rule was set
+		if(file_id == 0){
+			file.open(checkpoint::temporary(filename), std::ios::in | std::ios::out | std::ios::binary);
+			file_id = lock.inode();
+		}
+		if(!file.is_open() || lock.inode() != file_id){
+			//the table is completed or computed again by another job, so the rows are kept in memory
+			saving = false;
+			lock.release();
+			return;
+		}
+		read_rows();
+		for(auto it = pending.begin(); it != pending.end() && it->first < datapos.size(); )
+			it = pending.erase(it);
+		lock.cut(end);
+		file.seekp(end);
+		for(auto it = pending.begin(); it != pending.end() && it->first == datapos.size(); it = pending.erase(it)){
+			datapos.push_back(end);
+			this->moduleOper->save(it->second, file);
+			end = file.tellp();
+		}
+		file.flush();
+		if(datapos.size() == this->rank)
+			checkpoint::commit(filename);
+		lock.release();
+	}
+public:
+	//the constructor, with an empty filename the rows are only kept in memory
+	matrix_lazy(string fname = "") : filename(fname), end(0), lock(checkpoint::temporary(fname)), file_id(0), saving(false), mapped(fname), complete(false){
+		this->rank = 0; }
+
+	//set the rule of the rows, and read the rows already in the temporary file
+	void set_rule(unsigned rk, std::function<vectors<matrix_index,ring>(matrix_index)> rule){
+		std::lock_guard<std::mutex> lk(locker);
+		make_row = rule;
+		this->rank = rk;
+		pending.clear();
+		datapos.clear();
+		end = 0;
+		complete = false;
+		file_id = 0;
+		saving = false;
+		if(filename.empty())
+			return;
+		if(mapped.attach(rk)){
+			complete = true;
+			return;
+		}
+
+		if(file.is_open())
+			file.close();
+		saving = true;
+		//the rows are read later if the table is being written by another job
+		if(!lock.acquire(false, false, true)){
+			std::cout << checkpoint::temporary(filename) << " is locked\n" << std::flush;
+			return;
+		}
+		file_id = lock.inode();
+		file.open(checkpoint::temporary(filename), std::ios::in | std::ios::out | std::ios::binary);
+		if(!file.is_open()){
+			std::cerr << "fail to open " << checkpoint::temporary(filename) << "\n";
+			saving = false;
+			lock.release();
+			return;
+		}
+		read_rows();
+		lock.release();
+		std::cout << datapos.size() << "/" << rk << " rows read from " << checkpoint::temporary(filename) << "\n" << std::flush;
+	}
+
+	//the number of rows computed so far
+	unsigned computed() const{
+		if(complete)
+			return this->rank;
+		std::lock_guard<std::mutex> lk(locker);
+		return datapos.size() + pending.size();
+	}
+
+	//clear the contents, the file is kept
+	void clear(){
+		std::lock_guard<std::mutex> lk(locker);
+		pending.clear();
+		datapos.clear();
+		this->rank = 0;
+	}
+
+	//find the n-th row, computing it if it is not known
+	//two threads may compute the same row at the same time, and the first result is kept
+	vectors<matrix_index,ring> find(matrix_index n) const{
+		if(n >= this->rank){
+			std::cerr << "row " << n << " is out of the " << this->rank << " rows of " << filename << "\n";
+			abort();
+		}
+		if(complete)
+			return mapped.find(n);
+		{
+			std::lock_guard<std::mutex> lk(locker);
+			if(n < datapos.size()){
+				file.seekg(datapos[n]);
+				return this->moduleOper->load(file);
+			}
+			auto it = pending.find(n);
+			if(it != pending.end())
+				return it->second;
+		}
+		auto row = make_row(n);
+		std::lock_guard<std::mutex> lk(locker);
+		if(n >= datapos.size() && pending.emplace(n, row).second)
+			flush();
+		return row;
+	}
+
+	//insert a row
+	void insert(matrix_index i, vectors<matrix_index,ring> const& x){
+		std::lock_guard<std::mutex> lk(locker);
+		if(i >= this->rank)
+			this->rank = i+1;
+		if(i >= datapos.size() && pending.emplace(i, x).second)
+			flush();
+	}
+
+	//set the rank
+	void set_rank(unsigned n){
+		this->rank = n; }
+
+	//update all rows
+	void update_all(std::function<void(vectors<matrix_index,ring>&,matrix_index)> action){
+		std::cerr << "action not supported!"; }
+
+	//Gaussian ellimination
+	void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols){
+		std::cerr << "action not supported!"; }
+
+	//delete some columns and then do Gaussion
+	void del_and_gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::set<int> const &to_del){
+		std::cerr << "action not supported!"; }
+};
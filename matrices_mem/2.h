@@ -51,6 +51,9 @@ public:
 	//Gaussian ellimination, with given rows and colums
 	void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols);
 	
+	//Gaussian ellimination on independent blocks of rows, done in parallel
+	void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::vector<int> const &row_blocks);
+	
 	//delete some columns and then do Gaussion
 	void del_and_gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::set<int> const &to_del){
 		this->del_cols(to_del);
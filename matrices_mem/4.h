@@ -37,3 +37,59 @@ void matrix_mem<ring>::gaussian(std::vector<std::pair<matrix_index,matrix_index>
 		row_reduction(rc.first,rc.second);
 	}
 }
+
+//Gaussian ellimination on independent blocks of rows, each block is reduced by its own pivots
+template<typename ring>
+void matrix_mem<ring>::gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::vector<int> const &row_blocks){
+	if(row_blocks.size() != data.size()){
+		gaussian(row_cols);
+		return;
+	}
+	
+	//the rows and the pivots in each block
+	std::map<int,unsigned> block_index;
+	std::vector<std::vector<matrix_index>> rows;
+	std::vector<std::vector<std::pair<matrix_index,matrix_index>>> pivots;
+	for(unsigned i=0; i<data.size(); ++i){
+		auto it = block_index.emplace(row_blocks[i], rows.size()).first;
+		if(it->second == rows.size()){
+			rows.emplace_back();
+			pivots.emplace_back();
+		}
+		rows[it->second].push_back(i);
+	}
+	for(auto rc: row_cols)
+		pivots[block_index[row_blocks[rc.first]]].push_back(rc);
+	
+	//start with the large blocks
+	std::vector<unsigned> order(rows.size());
+	for(unsigned b=0; b<order.size(); ++b)
+		order[b] = b;
+	std::stable_sort(order.begin(), order.end(), [&rows](unsigned a, unsigned b){ return rows[a].size() > rows[b].size(); });
+	
+	//reduce a block, with the rows in parallel when the block is large
+	auto reduce_block = [this, &rows, &pivots] (unsigned b, bool large){
+		for(auto rc: pivots[b]){
+			//unify the given row
+			auto uv = unify(rc.second,data[rc.first]);
+			//transform the other rows in the block
+			#pragma omp parallel for schedule(dynamic) if(large)
+			for(unsigned k=0; k<rows[b].size(); ++k){
+				auto i = rows[b][k];
+				if(i==rc.first) data[i] = uv;
+				else take_away(rc.second, data[i], uv);
+			}
+		}
+	};
+	
+	//the large blocks one by one, and then the small blocks in parallel
+	unsigned large = 0;
+	while(large<order.size() && rows[order[large]].size()*8 > data.size()){
+		reduce_block(order[large++], true);
+		std::cout << "\r" << large << "/" << order.size() << std::flush;
+	}
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned k=large; k<order.size(); ++k)
+		reduce_block(order[k], false);
+	std::cout << "\r" << order.size() << "/" << order.size() << std::flush;
+}
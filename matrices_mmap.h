@@ -0,0 +1,247 @@
+//matrices_mmap.h
+#pragma once
+#include"matrices.h"
+#include<fstream>
+#include<streambuf>
+#include<cstdio>
+#include<fcntl.h>
+#include<unistd.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<sys/file.h>
+
+//a read-only stream buffer on a block of memory
+class memory_buffer : public std::streambuf{
+public:
+	memory_buffer(const char *begin, const char *end){
+		setg(const_cast<char*>(begin), const_cast<char*>(begin), const_cast<char*>(end)); }
+
+	//the position in the block
+	std::streamsize position(){
+		return gptr() - eback(); }
+};
+
+//a lock on the file a table is written to, shared by all the jobs
+//a table is written to its temporary file, and then renamed into place when it is complete, so a mapped table is never changed
+class file_lock{
+	string filename;
+	int fd;
+public:
+	//the constructor, the file is opened when the lock is taken
+	file_lock(string fname = "") : filename(fname), fd(-1){}
+
+	//the destructor
+	~file_lock(){
+		release(); }
+
+	//open the file and take the lock, return false if the lock is held by another job and wait is false
+	//it also fails if the file is renamed or removed meanwhile
+	bool acquire(bool wait, bool exclusive = true, bool create = false){
+		release();
+		fd = open(filename.c_str(), O_RDWR | (create ? O_CREAT : 0), 0644);
+		if(fd < 0)
+			return false;
+		struct stat st;
+		if(flock(fd, (exclusive ? LOCK_EX : LOCK_SH) | (wait ? 0 : LOCK_NB)) != 0 || stat(filename.c_str(), &st) != 0 || st.st_ino != inode()){
+			release();
+			return false;
+		}
+		return true;
+	}
+
+	//release the lock
+	void release(){
+		if(fd >= 0)
+			close(fd);
+		fd = -1;
+	}
+
+	//the inode of the locked file
+	ino_t inode() const{
+		struct stat st;
+		if(fd < 0 || fstat(fd, &st) != 0)
+			return 0;
+		return st.st_ino;
+	}
+
+	//cut the locked file to the given size
+	void cut(int64_t sz){
+		if(fd >= 0 && ftruncate(fd, sz) != 0)
+			std::cerr << "fail to cut " << filename << "\n";
+	}
+};
+
+//read-only matrix on a memory-mapped table, saved row by row
+//the jobs on the same node share the pages of the table, and the positions of the rows are published in filename + ".index" by the first job
+template<typename ring>
+class matrix_mmap : public matrix<ring>{
+	string filename;
+	//the mapped table
+	const char *data;
+	size_t size;
+	//the positions of the rows, followed by the end of the last row when the table is saved row by row
+	std::vector<int64_t> positions;
+
+	//the FNV-1a checksum of the mapped table
+	uint64_t checksum() const{
+		uint64_t h = 14695981039346656037ULL;
+		for(size_t i=0; i<size; ++i){
+			h ^= (unsigned char) data[i];
+			h *= 1099511628211ULL;
+		}
+		return h;
+	}
+
+	//read the published index, which has the size of the table, the rank, the checksum, and the positions
+	//an index of another table with the same size and rank is told apart by the checksum
+	bool read_index(unsigned rk, uint64_t sum){
+		std::fstream index(filename + ".index", std::ios::in | std::ios::binary);
+		int64_t sz = -1;
+		int32_t r = -1;
+		uint64_t s = 0;
+		index.read((char*)&sz, 8);
+		index.read((char*)&r, 4);
+		index.read((char*)&s, 8);
+		if(!index || sz != (int64_t)size || r != (int32_t)rk || s != sum)
+			return false;
+		positions.resize(rk+1);
+		index.read((char*)positions.data(), 8*(rk+1));
+		return (bool)index;
+	}
+
+	//publish the index, through a renamed temporary file so that the other jobs never see a partial one
+	void write_index(uint64_t sum){
+		string tmp = filename + ".index." + std::to_string(getpid());
+		std::fstream index(tmp, std::ios::out | std::ios::binary);
+		int64_t sz = size;
+		int32_t r = positions.size()-1;
+		index.write((char*)&sz, 8);
+		index.write((char*)&r, 4);
+		index.write((char*)&sum, 8);
+		index.write((char*)positions.data(), 8*positions.size());
+		index.close();
+		std::rename(tmp.c_str(), (filename + ".index").c_str());
+	}
+	//map the file, return false if it is empty or cannot be mapped
+	bool map_file(){
+		clear();
+		int fd = open(filename.c_str(), O_RDONLY);
+		if(fd < 0)
+			return false;
+		struct stat st;
+		if(fstat(fd, &st) != 0 || st.st_size == 0){
+			close(fd);
+			return false;
+		}
+		size = st.st_size;
+		void *p = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if(p == MAP_FAILED){
+			size = 0;
+			return false;
+		}
+		data = (const char*)p;
+		return true;
+	}
+public:
+	//the constructor
+	matrix_mmap(string fname) : filename(fname), data(NULL), size(0){
+		this->rank = 0; }
+
+	//the destructor
+	~matrix_mmap(){
+		clear(); }
+
+	//map the table, which should have rk rows. Return false if the table is not complete
+	bool attach(unsigned rk){
+		if(!map_file())
+			return false;
+
+		//find the positions of the rows if they are not published
+		uint64_t sum = checksum();
+		if(!read_index(rk, sum)){
+			memory_buffer buf(data, data + size);
+			std::iostream reader(&buf);
+			positions.assign(1, 0);
+			for(unsigned i=0; i<rk; ++i){
+				this->moduleOper->load(reader);
+				if(reader.fail())
+					break;
+				positions.push_back(buf.position());
+			}
+			if(positions.size() != rk+1){
+				clear();
+				return false;
+			}
+			write_index(sum);
+		}
+		this->rank = rk;
+		std::cout << filename << " mapped\n" << std::flush;
+		return true;
+	}
+
+	//map the file with the rows starting at the given positions, which may be in any order
+	bool attach(std::vector<int64_t> const &starts){
+		if(!map_file())
+			return false;
+		for(auto pos : starts)
+			if(pos < 0 || pos >= (int64_t)size){
+				clear();
+				return false;
+			}
+		positions = starts;
+		this->rank = starts.size();
+		return true;
+	}
+
+	//save the rows of M as the table, through a renamed temporary file
+	void publish(matrix<ring> *M){
+		string tmp = filename + "." + std::to_string(getpid());
+		std::fstream writer(tmp, std::ios::out | std::ios::binary);
+		for(unsigned i=0; i<M->rank; ++i)
+			matrix<ring>::moduleOper->save(M->find(i), writer);
+		writer.close();
+		std::rename(tmp.c_str(), filename.c_str());
+	}
+
+	//release the mapped table
+	void clear(){
+		if(data != NULL)
+			munmap((void*)data, size);
+		data = NULL;
+		size = 0;
+		positions.clear();
+		this->rank = 0;
+	}
+
+	//find the n-th row, which is read from the mapped table without locks
+	vectors<matrix_index,ring> find(matrix_index n) const{
+		if(n >= this->rank){
+			std::cerr << "row " << n << " is out of the " << this->rank << " rows of " << filename << "\n";
+			abort();
+		}
+		memory_buffer buf(data + positions[n], data + size);
+		std::iostream reader(&buf);
+		return this->moduleOper->load(reader);
+	}
+
+	//the table is read-only
+	void insert(matrix_index i, vectors<matrix_index,ring> const& x){
+		std::cerr << "action not supported!"; }
+
+	//set the rank
+	void set_rank(unsigned n){
+		std::cerr << "action not supported!"; }
+
+	//update all rows
+	void update_all(std::function<void(vectors<matrix_index,ring>&,matrix_index)> action){
+		std::cerr << "action not supported!"; }
+
+	//Gaussian ellimination
+	void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols){
+		std::cerr << "action not supported!"; }
+
+	//delete some columns and then do Gaussion
+	void del_and_gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::set<int> const &to_del){
+		std::cerr << "action not supported!"; }
+};
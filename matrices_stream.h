@@ -2,6 +2,7 @@
 #pragma once
 #include"matrices.h"
 #include"matrices_mem.h"
+#include"matrices_mmap.h"
 #include"streams.h"
 
 //matrix stored in streams
@@ -43,6 +44,10 @@ public:
 		datapos[i] = datas->write(writer);
 	}
 	
+	//the positions of the rows in the stream
+	std::vector<int64_t> row_positions() const{
+		return std::vector<int64_t>(datapos.begin(), datapos.end()); }
+	
 	//set the rank, note that the state is invalid after this operation
 	void set_rank(unsigned n){
 		this->rank = n;
@@ -62,6 +67,14 @@ public:
 		this->construct(&M);
 	}
 	
+	//Gaussian ellimination on independent blocks of rows
+	void gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::vector<int> const &row_blocks){
+		matrix_mem<ring> M;
+		M.construct(this);
+		M.gaussian(row_cols,row_blocks);
+		this->construct(&M);
+	}
+	
 	//delete some columns and then do Gaussion
 	void del_and_gaussian(std::vector<std::pair<matrix_index,matrix_index>> const &row_cols, std::set<int> const &to_del){
 		matrix_mem<ring> M;
@@ -75,6 +88,41 @@ public:
 template<typename ring>
 class matrix_file : public matrix_stream<ring>{
 	con_fstreams files;
+	//the rows mapped to memory, which are read without locks
+	matrix_mmap<ring> mapped;
 public:
-	matrix_file(string filename) : matrix_stream<ring>(&files), files(filename){}
+	matrix_file(string filename) : matrix_stream<ring>(&files), files(filename), mapped(filename){}
+	
+	//map the file, the mapping is released when the matrix is changed
+	void share_rows(){
+		files.fflush();
+		if(!mapped.attach(this->row_positions()))
+			mapped.clear();
+	}
+	
+	//clear the contents
+	void clear(){
+		mapped.clear();
+		matrix_stream<ring>::clear();
+	}
+	
+	//find the n-th row
+	vectors<matrix_index,ring> find(matrix_index n) const{
+		if(mapped.rank != 0)
+			return mapped.find(n);
+		return matrix_stream<ring>::find(n);
+	}
+	
+	//insert a new row
+	void insert(matrix_index i, vectors<matrix_index,ring> const& x){
+		if(mapped.rank != 0)
+			mapped.clear();
+		matrix_stream<ring>::insert(i, x);
+	}
+	
+	//set the rank
+	void set_rank(unsigned n){
+		mapped.clear();
+		matrix_stream<ring>::set_rank(n);
+	}
 };
@@ -88,6 +88,12 @@ public:
 	//desctructive reindex
 	template<typename index2>
 	vectors<index2,R> re_index(std::function<index2(index)> rule, vectors<index,R> &&x);
+	
+	//reindex by a rule keeping the order of the indices of x, so that no sorting is needed
+	template<typename index2>
+	vectors<index2,R> re_index_monotone(std::function<index2(index)> rule, vectors<index,R> const &x);
+	template<typename index2>
+	vectors<index2,R> re_index_monotone(std::function<index2(index)> rule, vectors<index,R> &&x);
 			
 	//reindex a vector, filtering out those unwanted terms, the rule produces the invalid index to indicate an unwanted term
 	template<typename index2>
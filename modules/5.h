@@ -39,11 +39,12 @@ void ModuleOp<index,R>::save(vectors<index,R> const &x, std::iostream& writer){
 //load the vector
 template<typename index, typename R>
 vectors<index,R> ModuleOp<index,R>::load(std::iostream& reader){
-	int32_t length;
+	//nothing is read after a failure, such as the end of a file cut off
+	int32_t length = 0;
 	reader.read((char*)&length,4);
 	
 	vectors<index,R> result;
-	for(int i=0; i<length; i++) {
+	for(int i=0; i<length && !reader.fail(); i++) {
 		typename vectors<index,R>::term newT;
 		reader.read((char*)&newT.ind, sizeof(index));
 		newT.coeficient = ringOper->load(reader);
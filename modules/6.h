@@ -27,6 +27,46 @@ vectors<index2,R> ModuleOp<index,R>::re_index(std::function<index2(index)> rule,
 	return res;
 }
 
+//check that a reindexed vector is still ordered, unless NDEBUG is defined
+template<typename index2, typename R>
+void check_monotone(vectors<index2,R> const &res){
+#ifndef NDEBUG
+	for(unsigned i=1; i<res.size(); ++i)
+		if(!(res.dataArray[i-1].ind < res.dataArray[i].ind)){
+			std::cerr << "the rule of re_index_monotone does not keep the order!";
+			abort();
+		}
+#endif
+}
+
+//reindex by an order preserving rule
+template<typename index, typename R>
+template<typename index2>
+vectors<index2,R> ModuleOp<index,R>::re_index_monotone(std::function<index2(index)> rule, vectors<index,R> const &x){
+	vectors<index2,R> res;
+	res.dataArray.resize(x.size());
+	for(unsigned i=0; i<x.size(); ++i){
+		res.dataArray[i].ind = rule(x.dataArray[i].ind);
+		res.dataArray[i].coeficient = x.dataArray[i].coeficient;
+	}
+	check_monotone(res);
+	return res;
+}
+
+//desctructive reindex by an order preserving rule
+template<typename index, typename R>
+template<typename index2>
+vectors<index2,R> ModuleOp<index,R>::re_index_monotone(std::function<index2(index)> rule, vectors<index,R> &&x){
+	vectors<index2,R> res;
+	res.dataArray.resize(x.size());
+	for(unsigned i=0; i<x.size(); ++i){
+		res.dataArray[i].ind = rule(x.dataArray[i].ind);
+		res.dataArray[i].coeficient = std::move(x.dataArray[i].coeficient);
+	}
+	check_monotone(res);
+	return res;
+}
+
 //reindex a vector, filtering out those unwanted terms, the rule produces the invalid index to indicate an unwanted term
 template<typename index, typename R> 
 template<typename index2>
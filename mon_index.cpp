@@ -53,8 +53,11 @@ void monomial_index::init_mon_array(){
 	}
 	
 	//construct the index of the monomials
-	for(int i=0; i<(int)mon_array.size(); ++i)
+	mon_rank.assign(totalMax, (matrix_index) -1);
+	for(int i=0; i<(int)mon_array.size(); ++i){
 		mon_index.emplace(mon_array[i],i);
+		mon_rank[mon_array[i]] = i;
+	}
 }
 
 //return the set of monomials in degree n
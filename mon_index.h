@@ -17,6 +17,8 @@ public:
 	std::vector<exponent> mon_array;
 	//the index of the monoials
 	std::map<exponent,matrix_index> mon_index;
+	//the index of the monomials as an array over the packed exponents
+	std::vector<matrix_index> mon_rank;
 	//number of monoials under a fixed degree
 	std::vector<unsigned> ranksBelow;
     
@@ -32,64 +34,147 @@ public:
 	//the number of all monoials
 	int number_of_all_mons();
 	
+	//the rank of an exponent which is not in the index
+	static constexpr matrix_index invalid_rank = (matrix_index) -1;
+	
+	//the position of a monomial in mon_array, or invalid_rank if it is not in the index
+	inline matrix_index rank(exponent e) const{
+		return e < mon_rank.size() ? mon_rank[e] : invalid_rank; }
+	
+	//the position of a monomial which has to be in the index
+	inline matrix_index rank_in_index(exponent e) const{
+		matrix_index r = rank(e);
+		if(r == invalid_rank){
+			std::cerr << "monomial " << output(e) << " is not in the index of degree " << max_degree << "\n";
+			abort();
+		}
+		return r;
+	}
+	
 	//the largest generator
 	int max_var;
     
 	//initialization
 	void init_mon_array();
 	
+	//count the entries already saved in writer, using skip to read one entry, and move the writer after the last complete one
+	int saved_entries(std::iostream &writer, std::function<bool(std::iostream&)> skip){
+		int count = 0;
+		std::streampos last = 0;
+		writer.seekg(0);
+		while(count < (int)mon_array.size() && writer.peek() != EOF && skip(writer)){
+			++count;
+			last = writer.tellg();
+		}
+		writer.clear();
+		writer.seekp(last);
+		return count;
+	}
+
 	//compute the table for some substitution rule
+	//each monomial is its previous monomial times a variable, and the monomials of a fixed degree are computed in parallel
+	//the products are not taken in the order of a computation from scratch, so the coefficients which vanish modulo the precision may be kept as explicit zeros at other places. The tables are equal as polynomials, but not always byte by byte
+	//if skip is given, the entries already in writer are read with it and not computed again
 	template<typename ring, typename output_type>
-	void substitution_table(std::function<ring(int)> values, std::iostream &writer, RingOp<ring> *ringop, std::function<output_type(const ring&)> rule, std::function<void(output_type const&, std::iostream&)> outputter){
-		//the values of the powers of the varaibles
+	void substitution_table(std::function<ring(int)> values, std::iostream &writer, RingOp<ring> *ringop, std::function<output_type(const ring&)> rule, std::function<void(output_type const&, std::iostream&)> outputter, std::function<bool(std::iostream&)> skip = nullptr){
+		int done = skip ? saved_entries(writer, skip) : 0;
+		if(done > 0)
+			std::cout << done << " entries found\n" << std::flush;
+
+		//the values of the variables
+		std::vector<ring> single(maxVar+1);
+		for(int i=1; i<=maxVar; ++i)
+			if(xnDeg(i)<=max_degree)
+				single[i] = values(i);
+
+		//the values of the powers of the varaibles, only needed for the monomials whose previous one is skipped
 		std::vector<std::vector<ring>> monos(maxVar+1);
-		for(int i=1; i<=maxVar; ++i){
-			//compute the i-th variables
-			monos[i].resize(xnMaxExpo[i]);
-			monos[i][0] = ringop->unit(1);
-			if(xnDeg(i)>max_degree) continue;
-			ring val = values(i);
-			for(int j=1; j*xnDeg(i)<=max_degree; ++j)
-				monos[i][j] = ringop->multiply(monos[i][j-1], val);
-		}
-		
-		std::cout << "computations of single factors complete\n" << std::flush;
-		
-		//compute all the monomials
-		int counter = 0;
-		for(auto e: mon_array){
+		if(done > 0)
+			for(int i=1; i<=maxVar; ++i){
+				monos[i].resize(xnMaxExpo[i]);
+				monos[i][0] = ringop->unit(1);
+				for(int j=1; j*xnDeg(i)<=max_degree; ++j)
+					monos[i][j] = ringop->multiply(monos[i][j-1], single[i]);
+			}
+		std::function<ring(exponent)> from_scratch = [&](exponent e){
 			ring ev = ringop->unit(1);
 			for(int k=1; k<=maxVar; ++k){
-				//load the power of the value of the k-th varaible
 				auto fct = xnVal(e,k);
 				if(fct!=0)
 					ev = ringop->multiply(ev,monos[k][fct]);
 			}
-			
-			std::cout << "\r" << counter++ << "/" << mon_array.size() << std::flush;
-			//save the result
-			outputter(rule(ev),writer);
+			return ev;
+		};
+
+		std::cout << "computations of single factors complete\n" << std::flush;
+
+		//the computed values, an entry is released once the degrees of the monomials following it are done
+		std::vector<ring> val(mon_array.size());
+		std::map<int,std::vector<int>> release;
+		int last_deg = max_degree + xnDeg(maxVar);
+		int start = 0;
+		for(int d=0; d<=max_degree; ++d){
+			int end = ranksBelow[d];
+			int from = start > done ? start : done;
+			std::vector<output_type> outputs(end > from ? end - from : 0);
+
+			#pragma omp parallel for schedule(dynamic)
+			for(int k=from; k<end; ++k){
+				exponent e = mon_array[k];
+				auto pr = previous(e);
+				if(pr.first == 0)
+					val[k] = ringop->unit(1);
+				else{
+					int q = rank_in_index(pr.second);
+					if(q < done)
+						val[k] = ringop->multiply(from_scratch(pr.second), single[pr.first]);
+					else
+						val[k] = ringop->multiply(val[q], single[pr.first]);
+				}
+				outputs[k-from] = rule(val[k]);
+			}
+
+			//save the results in order
+			for(auto &x : outputs)
+				outputter(x, writer);
+			if(end > from)
+				std::cout << "\r" << end << "/" << mon_array.size() << std::flush;
+
+			//the monomials following e are e times a variable of index at most the first variable of e
+			for(int k=from; k<end; ++k){
+				auto pr = previous(mon_array[k]);
+				int r = pr.first == 0 ? last_deg : d + xnDeg(pr.first);
+				release[r].push_back(k);
+			}
+			for(int k : release[d])
+				val[k] = ring();
+			release.erase(d);
+			start = end;
 		}
-		std::cout << "table complete\n" << std::flush;
+		std::cout << "\ntable complete\n" << std::flush;
 	}
-	
+
 	//compute the table for some substitution rule
+	//if resume is set, the entries already in writer are kept
 	template<typename ring>
-	void substitution_table(std::function<ring(int)> values, std::iostream &writer, RingOp<ring> *ringop){
+	void substitution_table(std::function<ring(int)> values, std::iostream &writer, RingOp<ring> *ringop, bool resume = false){
 		std::function<ring(const ring&)> id = [](const ring &x){ 
 			return x; };
 		std::function<void(const ring&, std::iostream&)> outputter = [ringop](const ring &x, std::iostream &writer){
 			ringop->save(x,writer); };
+		std::function<bool(std::iostream&)> skip = [ringop](std::iostream &reader){
+			ringop->load(reader);
+			return !reader.fail(); };
 		
-		substitution_table(values, writer, ringop, id, outputter);
+		substitution_table(values, writer, ringop, id, outputter, resume ? skip : nullptr);
 	}
 	
 	
-	//change to vector notation
+	//change to vector notation, the terms above the maximal degree are dropped
 	template<typename base_ring>
 	vectors<matrix_index,base_ring> poly2vec(polynomial<base_ring> const &x, ModuleOp<exponent,base_ring> *modoper){
 		std::function<matrix_index(exponent)> rule = [this](exponent e){
-			return mon_index[e]; };
-			return modoper->re_index(rule,x);
+			return rank(e); };
+		return modoper->filtered_reindex(rule, x, invalid_rank);
 	}
 };
@@ -7,6 +7,8 @@ int main(int agrc, char **argv){
 	//get the maximal degree and the length of the resolution
 	int max_deg = std::atoi(argv[1]);
 	int resolution_length = std::atoi(argv[2]);
+	//the length of a previous run to be extended
+	int previous = agrc>3 ? std::atoi(argv[3]) : -1;
 	string directory(argv[1]);
 	directory += "_";
 	string director = directory;
@@ -14,15 +16,16 @@ int main(int agrc, char **argv){
 	//initialize matrix class
 	matrix<tauPoly>::moduleOper = &tau_module_oper;
 	matrix<motSteenrod>::moduleOper = &motSteenrod_module_oper;
-	//the matrix of the coactions
+	//the matrix of the coactions, and the table shared by the jobs of the same maximal degree
 	matrix_mem<motSteenrod> coa;
+	matrix_mmap<motSteenrod> shared_coa(directory + "mot_coa");
 	//the operator for motivic dual steenrid algebra
 	MotSteenrodOp MOP(&coa, max_deg);
 	//initialize the list of monomials
 	MOP.init_mon_array(directory + "ex2poly_index");
 	std::cout << MOP.output_monomials();
 
-	MOP.generate_cofree_coaction(directory + "mot_deltas", directory + "poly_exponents");
+	MOP.generate_cofree_coaction(directory + "mot_deltas", directory + "poly_exponents", &shared_coa);
 	// std::cout << coa.output();
 	
 	//the comodule to be resolved
@@ -53,8 +56,20 @@ int main(int agrc, char **argv){
 	//load the generators
 	MOP.load_gens(gens, director + "gens_data_ctau");
 	
+	//resume from the manifest if no previous run is given
+	checkpoint progress(director + "mot_manifest");
+	if(previous<0)
+		previous = progress.resume("resolve");
+	std::function<void(int)> step_done = [&progress, director](int i){
+		std::vector<string> files = {director + "mot_maps" + std::to_string(i), director + "mot_gens" + std::to_string(i)};
+		if(i==0){
+			progress.reset("resolve");
+			files.push_back(director + "mot_gens");
+		}
+		progress.complete("resolve", i, files); };
+	
 	//construct the pre-resolution
-	MOP.pre_resolution_modeled(comod, director + "mot_maps", director + "mot_gens", resolution_length, director+"extables", &ctable, gens, tfm, &inj, &qut, &indj, &new_map, director + "back");
+	MOP.pre_resolution_modeled(comod, director + "mot_maps", director + "mot_gens", resolution_length, director+"extables", &ctable, gens, tfm, &inj, &qut, &indj, &new_map, director + "back", previous, step_done);
 	
 	//combining generator files
 	MOP.gens_file_combiner(director + "mot_gens", resolution_length, comod);
@@ -188,7 +188,13 @@ motSteenrod MotSteenrodOp::vector2algebroid(vectors<matrix_index,tauPoly> const
 }
     
 //generate the cofree coaction
-void MotSteenrodOp::generate_cofree_coaction(string coaction_filename, string expo_filename){
+void MotSteenrodOp::generate_cofree_coaction(string coaction_filename, string expo_filename, matrix_mmap<motSteenrod> *shared){
+	if(shared != NULL && shared->attach(mon_array.size())){
+		cofree_coaction = shared;
+		init_cofree_degrees();
+		return;
+	}
+	
 	//transform the data of coactions
 	std::fstream coaction_file(coaction_filename, std::ios::in | std::ios::binary);
 	std::fstream expo_file(expo_filename, std::ios::in | std::ios::binary);
@@ -205,8 +211,20 @@ void MotSteenrodOp::generate_cofree_coaction(string coaction_filename, string ex
 		auto so = motSteenrod_module_oper.scalor_mult(etaL(tauPoly(-tauVal(mon_array[n]))), algebroid2vectorSt(coactor));
 		this->cofree_coaction->insert(n, so);
 	}
-      
-	//initialize the degrees
+	
+	//publish the coactions, and release our copy once they are mapped
+	if(shared != NULL){
+		shared->publish(cofree_coaction);
+		if(shared->attach(mon_array.size())){
+			cofree_coaction->clear();
+			cofree_coaction = shared;
+		}
+	}
+	init_cofree_degrees();
+}
+
+//initialize the degrees
+void MotSteenrodOp::init_cofree_degrees(){
 	static std::function<MotDegree(matrix_index)> degs =  [this](matrix_index n){ 
 		return this->cofree_degs(n); };
 	this->init_cofree_data<MotDegree>(degs);
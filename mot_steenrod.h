@@ -1,6 +1,7 @@
  #pragma once
 
 #include "hopf_algebroid.h"
+#include "matrices_mmap.h"
 #include "exponents.h"
 #include "Fp.h"
 
@@ -107,7 +108,10 @@ public:
 	vectors<matrix_index,motSteenrod> algebroid2vectorSt(mStmSt const &x);
     
 	//generate data for the coactions
-	void generate_cofree_coaction(string coaction_filename, string expo_filename);
+	//if shared is given, the coactions are published to its table once, and the jobs of the same degree map it instead
+	void generate_cofree_coaction(string coaction_filename, string expo_filename, matrix_mmap<motSteenrod> *shared = NULL);
+	//initialize the degrees of the cofree comodules
+	void init_cofree_degrees();
 
 	//left and right units
 	motSteenrod etaR(const tauPoly &x);
@@ -30,26 +30,37 @@ void multiplication::multily_matrix(int max_deg, matrix<BP> *multiplier, matrix<
 		auto v = res_map->maps_to(F->multiply_using_table(i,*multiplier));
 		return prim_next->expand(v);
 	};
-	result->construct(F->rank(),rows);
+	result->construct_parallel(F->rank(),rows);
+}
+
+//multiply a list of vectors and name the products in a table, in parallel
+//each factor is given by its name, its vector, and whether the cycles in its product are checked
+template<typename cycle_name, typename ring>
+multiplication_table<cycle_name> multiplication::mult_batch(matrix_mem<ring> *mult_matrix, std::vector<std::tuple<cycle_name, typename SS_entry<cycle_name,ring>::value_type const*, bool>> const &factors, SS_table<cycle_name,ring> &next_table, SS_table<cycle_name,ring> &third_table, int pric){
+	multiplication_table<cycle_name> res(factors.size());
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned k=0; k<factors.size(); ++k){
+		//get the image under multiplication
+		auto v = mult_matrix->maps_to(*std::get<1>(factors[k]));
+		//construct the new entry
+		auto cycls = next_table.name_of_cycle(v,&third_table,pric,std::get<2>(factors[k]));
+		res[k] = {std::get<0>(factors[k]), next_table.combine_cycles(cycls)};
+	}
+	return res;
 }
 
 //make multiplication table
 template<typename cycle_name, typename ring>
-multiplication_table<cycle_name> multiplication::mult_extension(matrix<ring> *mult_matrix, SS_table<cycle_name,ring> &cur_table, SS_table<cycle_name,ring> &next_table, SS_table<cycle_name,ring> &third_table, int pric){
-	multiplication_table<cycle_name> res;
+multiplication_table<cycle_name> multiplication::mult_extension(matrix_mem<ring> *mult_matrix, SS_table<cycle_name,ring> &cur_table, SS_table<cycle_name,ring> &next_table, SS_table<cycle_name,ring> &third_table, int pric){
+	std::vector<std::tuple<cycle_name, typename SS_entry<cycle_name,ring>::value_type const*, bool>> factors;
 	//compute the extensions for the entries in the table
 	for(auto &tm : cur_table){
 		//skip invalid entries
 		if(!cur_table.valid(tm.cycle)) continue;
 		//skip the tagged entries
 		if(cur_table.tagged(tm)) continue;
-		//get the image of the full cycle under multiplication
-		auto v = mult_matrix->maps_to(tm.full_cycle);
-		//construct the new entry
-		auto cycls = next_table.name_of_cycle(v,&third_table,pric);
-		auto cm = next_table.combine_cycles(cycls);
-		multiplication_table_entry<cycle_name> nm = {tm.cycle,cm};
-		res.push_back(nm);
+		//the image of the full cycle under multiplication
+		factors.push_back(std::make_tuple(tm.cycle, &tm.full_cycle, true));
 	}
 	
 	//then deal with the tags
@@ -60,57 +71,40 @@ multiplication_table<cycle_name> multiplication::mult_extension(matrix<ring> *mu
 		if(!next_table.tagged(tm)) continue;
 		//skip tags with non-trivial boundaries
 		if(next_table.filtration(tm.cycle)<pric) continue;
-		auto v = mult_matrix->maps_to(tm.full_tag);
-		//construct new entry
-		auto cycls = next_table.name_of_cycle(v,&third_table,pric);
-		auto cm = next_table.combine_cycles(cycls);
-		multiplication_table_entry<cycle_name> nm = {tm.tag,cm};
-		res.push_back(nm);
+		factors.push_back(std::make_tuple(tm.tag, &tm.full_tag, true));
 	}
-	return res;
+	return mult_batch(mult_matrix, factors, next_table, third_table, pric);
 }
 
 //make multiplication table
 template<typename cycle_name, typename ring>
-multiplication_table<cycle_name> multiplication::mult_extension1(matrix<ring> *mult_matrix, SS_table<cycle_name,ring> &cur_table, SS_table<cycle_name,ring> &next_table, SS_table<cycle_name,ring> &third_table, int pric){
-	multiplication_table<cycle_name> res;
-	int counter = 0;
+multiplication_table<cycle_name> multiplication::mult_extension1(matrix_mem<ring> *mult_matrix, SS_table<cycle_name,ring> &cur_table, SS_table<cycle_name,ring> &next_table, SS_table<cycle_name,ring> &third_table, int pric){
+	std::vector<std::tuple<cycle_name, typename SS_entry<cycle_name,ring>::value_type const*, bool>> factors;
 	//compute the extensions for the entries in the table
 	for(auto &tm : cur_table){
-		std::cout << "\r" << counter++;
 		//skip invalid entries
 		if(!cur_table.valid(tm.cycle)) continue;
 		//skip the tagged entries
 		if(cur_table.tagged(tm)) continue;
 		//skip
 		if(cur_table.filtration(tm.cycle)>=pric) continue;
-		//get the image of the full cycle under multiplication
-		auto v = mult_matrix->maps_to(tm.full_cycle);
-		//construct the new entry
-		auto cycls = next_table.name_of_cycle(v,&third_table,pric);
-		auto cm = next_table.combine_cycles(cycls);
-		multiplication_table_entry<cycle_name> nm = {tm.cycle,cm};
-		res.push_back(nm);
+		//the image of the full cycle under multiplication
+		factors.push_back(std::make_tuple(tm.cycle, &tm.full_cycle, true));
 	}
 	
 	//then deal with the tags
 	for(auto &tm : next_table){
-		std::cout << "\r" << counter++ << "/" << next_table.size();
 		//skip invalid entries
 		if(!next_table.valid(tm.cycle)) continue;
 		//skip untagged entries
 		if(!next_table.tagged(tm)) continue;
 		//skip
-		std::cout << cur_table.filtration(tm.tag);
 		if(cur_table.filtration(tm.tag)>=pric) continue;
-		auto v = mult_matrix->maps_to(tm.full_tag);
-		//construct new entry
-		auto cycls = next_table.name_of_cycle(v,&third_table,pric,false);
-		auto cm = next_table.combine_cycles(cycls);
-		multiplication_table_entry<cycle_name> nm = {tm.tag,cm};
-		res.push_back(nm);
+		//the cycles of the image of a tag are not checked
+		factors.push_back(std::make_tuple(tm.tag, &tm.full_tag, false));
 	}
-	return res;
+	std::cout << factors.size() << " products\n" << std::flush;
+	return mult_batch(mult_matrix, factors, next_table, third_table, pric);
 }
 
 //make multiplacation table from the algebraic Novikov table of a complex
@@ -127,7 +121,10 @@ std::vector<multiplication_table<cycle_name>> multiplication::mult_extension(mat
 		multily_matrix(max_deg, multiplier, mp, &generators[i-1], &Cm.Prims[i], mm);
 		//compute the multiplication table for the current term in the resolution
 		int cpric = fixedpric ? pric : pric-i;
-		multiplication_table<cycle_name> new_table = mult_extension<cycle_name,Z3>(mm, *(Tb.tables)[i-1], *(Tb.tables)[i], *(Tb.tables)[i+1], cpric);
+		//the rows are read in parallel, so the matrix is copied to the memory once
+		matrix_mem<Z3> mult_matrix;
+		mult_matrix.construct(mm);
+		multiplication_table<cycle_name> new_table = mult_extension<cycle_name,Z3>(&mult_matrix, *(Tb.tables)[i-1], *(Tb.tables)[i], *(Tb.tables)[i+1], cpric);
 		result.push_back(new_table);
 	}
 	return result;
@@ -148,12 +145,57 @@ std::vector<multiplication_table<cycle_name>> multiplication::mult_extension1(ma
 		multily_matrix(max_deg, multiplier, mp, &generators[i-1], &Cm.Prims[i], mm);
 		//compute the multiplication table for the current term in the resolution
 		int cpric = fixedpric ? pric : pric-i;
-		multiplication_table<cycle_name> new_table = mult_extension1<cycle_name,Z3>(mm, *(Tb.tables)[i-1], *(Tb.tables)[i], *(Tb.tables)[i+1], cpric);
+		//the rows are read in parallel, so the matrix is copied to the memory once
+		matrix_mem<Z3> mult_matrix;
+		mult_matrix.construct(mm);
+		multiplication_table<cycle_name> new_table = mult_extension1<cycle_name,Z3>(&mult_matrix, *(Tb.tables)[i-1], *(Tb.tables)[i], *(Tb.tables)[i+1], cpric);
 		result.push_back(new_table);
 	}
 	return result;
 }
 
+//make the multiplication tables of several requests in one pass over the resolution
+void multiplication::mult_extensions(std::vector<std::pair<BPBP,int>> const &multipliers, std::vector<product_request> &requests, int max_deg, int resolution_length, std::vector<FreeBPCoMod>& generators, string maps_filename, BPComplex& Cm, matrix<BP> *mp, matrix<Z3> *mm){
+	//make the multiplication tables on BPBP
+	std::vector<matrix_mem<BP>> mult(multipliers.size());
+	for(unsigned k=0; k<multipliers.size(); ++k)
+		make_eta_R_multiplier(multipliers[k].first, &mult[k], multipliers[k].second);
+	for(auto &rq : requests)
+		rq.result.clear();
+	
+	//open the files of the maps
+	std::fstream maps_file(maps_filename, std::ios::in | std::ios::binary);
+	//make the tables for each term in the resolution
+	for(int i=1;i<resolution_length-1;++i){
+		std::cout << "\n" << i << std::flush;
+		//load the maps in the resolution
+		mp->load(maps_file);
+		for(unsigned k=0; k<multipliers.size(); ++k){
+			//compute the matrix for the multiplication, if it is requested
+			bool used = false;
+			for(auto &rq : requests)
+				if(rq.multiplier==(int)k) used = true;
+			if(!used) continue;
+			mm->clear();
+			multily_matrix(max_deg - multipliers[k].second, &mult[k], mp, &generators[i-1], &Cm.Prims[i], mm);
+			//the rows are read in parallel by every request, so the matrix is copied to the memory once
+			matrix_mem<Z3> mult_matrix;
+			mult_matrix.construct(mm);
+			
+			//compute the multiplication tables for the current term in the resolution
+			for(auto &rq : requests){
+				if(rq.multiplier!=(int)k) continue;
+				int cpric = rq.fixedpric ? rq.pric : rq.pric-i;
+				auto &Tb = rq.tables->tables;
+				if(rq.bounded)
+					rq.result.push_back(mult_extension1<cycle_name,Z3>(&mult_matrix, *Tb[i-1], *Tb[i], *Tb[i+1], cpric));
+				else
+					rq.result.push_back(mult_extension<cycle_name,Z3>(&mult_matrix, *Tb[i-1], *Tb[i], *Tb[i+1], cpric));
+			}
+		}
+	}
+}
+
 //output the table
 template<typename cycle_name, typename ring>
 string multiplication::output_multiplication_table(multiplication_table<cycle_name> const &MT, int k, int shift, int pric, SS_table<cycle_name, ring> &Tb){
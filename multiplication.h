@@ -2,6 +2,7 @@
 #pragma once
 
 #include "algNov.h"
+#include "matrices_mem.h"
 
 //the entries in a multiplacation table
 template<typename cycle_name>
@@ -15,6 +16,21 @@ struct multiplication_table_entry {
 template<typename cycle_name>
 using  multiplication_table = std::vector<multiplication_table_entry<cycle_name>>;
 
+//a request for the products by a multiplier, named in a family of tables
+struct product_request{
+	//the index of the multiplier
+	int multiplier;
+	//the tables for naming the products
+	algNov_tables *tables;
+	//the pricision, which decreases along the resolution unless fixed
+	int pric;
+	bool fixedpric;
+	//skip the entries beyond the pricision, as mult_extension1 does
+	bool bounded;
+	//the tables of products
+	std::vector<multiplication_table<cycle_name>> result;
+};
+
 
 //the class to produce the multiplicative structure
 class multiplication{
@@ -28,21 +44,30 @@ public:
 	//compute the multiplication table for x->v\eta_R(x)
 	void make_eta_R_multiplier(BPBP const&,matrix<BP>* result, int deg);
 	
+	//multiply a list of vectors and name the products in a table
+	//the rows of the multiplication matrix are read in parallel
+	template<typename cycle_name, typename ring>
+	static multiplication_table<cycle_name> mult_batch(matrix_mem<ring>*, std::vector<std::tuple<cycle_name, typename SS_entry<cycle_name,ring>::value_type const*, bool>> const&, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, int);
+	
 	//construct the multiplication matrix
 	void multily_matrix(int max_deg, matrix<BP> *multiplier, matrix<BP> *resolv_map, FreeBPCoMod*, primitive_data*, matrix<Z3> *result);
 	
 	template<typename cycle_name, typename ring>
-	static multiplication_table<cycle_name> mult_extension(matrix<ring>*, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, int);
+	static multiplication_table<cycle_name> mult_extension(matrix_mem<ring>*, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, int);
 	
 	//make multiplacation table from the algebraic Novikov table of a complex
 	std::vector<multiplication_table<cycle_name>> mult_extension(matrix<BP>*, int, int, std::vector<FreeBPCoMod>&, string, BPComplex&, algNov_tables, matrix<BP>*, matrix<Z3>*, int pric, bool fixedpric=false);
         
         template<typename cycle_name, typename ring>
-	static multiplication_table<cycle_name> mult_extension1(matrix<ring>*, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, int);
+	static multiplication_table<cycle_name> mult_extension1(matrix_mem<ring>*, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, SS_table<cycle_name,ring>&, int);
 	
 	//make multiplacation table from the algebraic Novikov table of a complex
 	std::vector<multiplication_table<cycle_name>> mult_extension1(matrix<BP>*, int, int, std::vector<FreeBPCoMod>&, string, BPComplex&, algNov_tables, matrix<BP>*, matrix<Z3>*, int pric, bool fixedpric=false);
 	
+	//make the multiplication tables of several requests in one pass over the resolution
+	//the multipliers are given with their degrees, and each map of the resolution is read once for all of them
+	void mult_extensions(std::vector<std::pair<BPBP,int>> const &multipliers, std::vector<product_request> &requests, int max_deg, int resolution_length, std::vector<FreeBPCoMod>&, string, BPComplex&, matrix<BP>*, matrix<Z3>*);
+	
 	//computing the table for multiplication by three
 	template<typename cycle_name, typename ring>
 	multiplication_table<cycle_name> three_extension(SS_table<cycle_name,ring>& cur_table, int pric);
@@ -0,0 +1,115 @@
+//pipeline.cpp
+//run mr_st, BPtab and mr_BP as one pipeline, the first two concurrently
+#include"checkpoint.h"
+#include<iostream>
+#include<thread>
+#include<cstdlib>
+#include<unistd.h>
+
+//a stage of the pipeline, run as a separate program
+typedef struct{
+	//the program, which also names the log file
+	string name;
+	//the parameters
+	string args;
+	//the indices of the stages it depends on
+	std::vector<int> deps;
+	//the files it produces
+	std::vector<string> outputs;
+	//the manifest of its own steps
+	string manifest;
+} stage;
+
+int main(int argc, char** argv){
+	if(argc<3){
+		std::cerr << "usage: " << argv[0] << " half_of_t s_BP [s_st]\n";
+		return 1;
+	}
+	int max_degree = std::atoi(argv[1]);
+	int length_BP = std::atoi(argv[2]);
+	int length_st = argc>3 ? std::atoi(argv[3]) : length_BP + 1;
+
+	//check the parameters before anything is run
+	if(max_degree<=0 || length_BP<=0){
+		std::cerr << "the degree and the length should be positive\n";
+		return 1;
+	}
+	//the resolution of BP is modeled on the one of BP/I, which needs one more step
+	if(length_st < length_BP+1){
+		std::cerr << "the s for BP/I should be at least " << length_BP+1 << "\n";
+		return 1;
+	}
+	for(string exe : {"mr_st", "BPtab", "mr_BP"})
+		if(access(("./" + exe).c_str(), X_OK) != 0){
+			std::cerr << "./" << exe << " is not found, compile it first\n";
+			return 1;
+		}
+
+	string t = argv[1];
+	string st = t + "_", BP = t + "_BP";
+
+	std::vector<stage> stages = {
+		{"mr_st", t + " " + std::to_string(length_st), {}, {st + "ResTables", st + "gens_data", st + "BPtables"}, st + "manifest"},
+		{"BPtab", t, {}, {st + "etaL", st + "R2L", st + "delta"}, ""},
+		{"mr_BP", t + " " + std::to_string(length_BP), {0, 1}, {BP + "AANSS_table.txt", BP + "BocSS_table.txt", BP + "B2A_table.txt", BP + "AANSS_h0.txt", BP + "BocSS_h0.txt", BP + "AANSS_massey_h0.txt"}, BP + "manifest"}};
+	//the manifest of the pipeline, a stage is recorded under its name and parameters
+	checkpoint progress(st + "pipeline");
+	auto key = [&stages](int i){
+		string k = stages[i].name + "_" + stages[i].args;
+		for(auto &c : k)
+			if(c==' ') c = '_';
+		return k; };
+
+	//0 for pending, 1 for run in this call, 2 for already up to date, -1 for failed
+	std::vector<int> state(stages.size(), 0);
+	for(bool pending = true; pending; ){
+		pending = false;
+		//the stages whose dependencies are all done
+		std::vector<int> ready;
+		for(unsigned i=0; i<stages.size(); ++i){
+			if(state[i]!=0) continue;
+			bool ok = true;
+			for(int d : stages[i].deps)
+				if(state[d]<=0) ok = false;
+			if(ok) ready.push_back(i);
+		}
+
+		std::vector<std::thread> runners;
+		for(int i : ready){
+			auto &sg = stages[i];
+			bool upstream = false;
+			for(int d : sg.deps)
+				if(state[d]==1) upstream = true;
+			if(!upstream && progress.completed(key(i))){
+				std::cout << sg.name << " " << sg.args << " is up to date\n" << std::flush;
+				state[i] = 2;
+				continue;
+			}
+			//the inputs have changed, so the steps of a previous run can not be reused
+			if(upstream && sg.manifest!="")
+				std::remove(sg.manifest.c_str());
+			progress.reset(key(i));
+
+			string command = "./" + sg.name + " " + sg.args;
+			std::cout << "running " << command << "\n" << std::flush;
+			runners.push_back(std::thread([command, &state, i, t, &sg](){
+				int r = std::system((command + " > " + t + "_" + sg.name + ".log 2>&1").c_str());
+				state[i] = r==0 ? 1 : -1; }));
+		}
+		for(auto &th : runners)
+			th.join();
+
+		for(int i : ready){
+			if(state[i]==1)
+				progress.complete(key(i), -1, stages[i].outputs);
+			if(state[i]<0){
+				std::cerr << stages[i].name << " failed, see " << t << "_" << stages[i].name << ".log\n";
+				return 1;
+			}
+		}
+		for(unsigned i=0; i<stages.size(); ++i)
+			if(state[i]==0) pending = true;
+	}
+	std::cout << "done\n";
+	return 0;
+}
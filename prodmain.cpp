@@ -0,0 +1,58 @@
+//prodmain.cpp
+//the products in the Ext of the minimal resolution of mr_st, by lifting the cocycles to chain maps
+#include"steenrod_init.h"
+#include"lift.h"
+
+int main(int argc, char** argv){
+	if(argc<3){
+		std::cerr << "usage: " << argv[0] << " half_of_t s [s of the multipliers]\n";
+		return 1;
+	}
+	string filename = argv[1];
+	filename += "_";
+
+	int maxdeg = std::atoi(argv[1]);
+	int length = std::atoi(argv[2]);
+	//the multipliers are the co-generators of F_s with 0<s<=max_s
+	int max_s = argc>3 ? std::atoi(argv[3]) : 1;
+
+	SteenrodInit st(3, maxdeg, length, filename + "steenrod_coaction.data", true);
+	auto &HA = st.steenrod_oper;
+
+	//load the resolution
+	resolution_data<Fp,P,int> R(length);
+	R.load(HA, filename);
+	int len = R.terms.size();
+
+	//the multipliers
+	std::vector<std::pair<int,int>> multipliers;
+	for(int s=1; s<=max_s && s<len; ++s)
+		for(int g=0; g<(int)R.terms[s].F.generators.rank; ++g)
+			multipliers.push_back(std::make_pair(s,g));
+
+	//the chain maps of the multipliers are independent
+	std::vector<std::vector<std::vector<vectors<matrix_index,Fp>>>> products(multipliers.size());
+	#pragma omp parallel for schedule(dynamic)
+	for(unsigned k=0; k<multipliers.size(); ++k){
+		products[k] = resolution_lift(R, multipliers[k].first, multipliers[k].second, HA);
+		#pragma omp critical
+		std::cout << "\r" << k+1 << "/" << multipliers.size() << " lifted" << std::flush;
+	}
+
+	//output the nontrivial products, [s-g][j-h] -> sum of the co-generators of F_{s+j}
+	string res;
+	for(unsigned k=0; k<multipliers.size(); ++k){
+		int s = multipliers[k].first;
+		string x = "[" + std::to_string(s) + "-" + std::to_string(multipliers[k].second) + "]";
+		for(unsigned j=0; j<products[k].size(); ++j)
+			for(unsigned h=0; h<products[k][j].size(); ++h){
+				auto &v = products[k][j][h];
+				if(HA.FpMod_opers.isZero(v)) continue;
+				res += x + "[" + std::to_string(j) + "-" + std::to_string(h) + "]\t->\t" + HA.FpMod_opers.output(v, std::to_string(s+j)) + "\n";
+			}
+	}
+	std::fstream output_file(filename + "products.txt", std::ios::out);
+	output_file << res;
+	std::cout << "\ndone\n";
+	return 0;
+}
@@ -3,6 +3,7 @@
 
 //the initialization
 SteenrodInit::SteenrodInit(int prime, int max_deg, int res_length, string delta_data, bool IorO) : steenrod_oper(max_deg, prime, &deltaTable){
+	resolution_length = res_length;
 	//the delta data file does not exist
 	if(!IorO){
 		//open the file for writing
@@ -13,8 +14,6 @@ SteenrodInit::SteenrodInit(int prime, int max_deg, int res_length, string delta_
 		steenrod_oper.make_delta(delta_file);
 		delta_file.close();
 		
-		resolution_length = res_length;
-		
 		std::cout << "maximal degree:" << steenrod_oper.maxDeg << "\n";
 		std::cout << "resolution length:" << res_length << "\n";
 	}
@@ -43,22 +42,34 @@ ComodInit::ComodInit() : SteenrodCoMod_generic(&coaction_matrix){
 }
 
 //do resolutions
-void SteenrodInit::resolve(string director, std::vector<std::vector<int>> *basis_orders){
-	steenrod_oper.pre_resolution_tab(comod, director + "maps", director + "gens", resolution_length, resolutionTables, gens, &inj, &indj, &qut, &new_map, director + "BPtables");
+void SteenrodInit::resolve(string director, std::vector<std::vector<int>> *basis_orders, int res_start){
+	checkpoint progress(director + "manifest");
+	if(res_start<0)
+		res_start = progress.resume("resolve");
+	
+	//record the parts of the files written by each step
+	std::function<void(int)> step_done = [&progress, director](int i){
+		if(i==0)
+			progress.reset("resolve");
+		progress.complete("resolve", i, {director + "maps", director + "gens", director + "BPtables"}); };
+	
+	steenrod_oper.pre_resolution_tab(comod, director + "maps", director + "gens", resolution_length, resolutionTables, gens, &inj, &indj, &qut, &new_map, director + "BPtables", basis_orders, director + "back", res_start, step_done);
 }
 
 
 //save the resolution tables
 void SteenrodInit::saveResolutionTables(string table_data){
-	std::fstream tables(table_data, std::ios::out | std::ios::binary);
+	std::fstream tables(checkpoint::temporary(table_data), std::ios::out | std::ios::binary);
 	for(unsigned i=0; i<ResolutionTables.size(); ++i){
 		ResolutionTables[i].save(tables);
 	}
+	tables.close();
+	checkpoint::commit(table_data);
 }
 
 //save the generators, 4 bytes size, then for each of the generator sets
 void SteenrodInit::save_gens(string gens_data){
-	std::fstream genfile(gens_data, std::ios::out | std::ios::binary);
+	std::fstream genfile(checkpoint::temporary(gens_data), std::ios::out | std::ios::binary);
 	int32_t sz = gens.size();
 	genfile.write((char*)&sz, 4);
 	for(int i=0; i<sz; ++i){
@@ -67,5 +78,7 @@ void SteenrodInit::save_gens(string gens_data){
 		for(int j=0; j<ss; ++j)
 			genfile.write((char*)&gens[i][j], 4);
 	}
+	genfile.close();
+	checkpoint::commit(gens_data);
 }
 
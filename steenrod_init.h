@@ -2,6 +2,7 @@
 #pragma once
 #include"steenrod.h"
 #include"matrices_mem.h"
+#include"checkpoint.h"
 
 //initialize a generic comodule
 class ComodInit : public SteenrodCoMod_generic{
@@ -39,8 +40,8 @@ public:
 	//the constructor
 	SteenrodInit(int prime, int max_deg, int resolution_length, string delta_data, bool IorO=false);
 	
-	//do resolutions
-	void resolve(string director, std::vector<std::vector<int>> *basis_orders = NULL);
+	//do resolutions, extending a previous run of length res_start if res_start>=0, otherwise resuming from the manifest of the director
+	void resolve(string director, std::vector<std::vector<int>> *basis_orders = NULL, int res_start = -1);
 	
 	//save the resolution tables
 	void saveResolutionTables(string);
@@ -7,12 +7,14 @@ int main(int argc, char** argv){
 	
 	int maxdeg = std::atoi(argv[1]);
 	int length = std::atoi(argv[2]);
+	//the length of a previous run to be extended
+	int previous = argc>3 ? std::atoi(argv[3]) : -1;
 	
 	SteenrodInit st(3,maxdeg, length, filename + "steenrod_coaction.data");
 	
 //	std::cout<<st.steenrod_oper.delta_table->output();
 	
-	st.resolve(filename);
+	st.resolve(filename, NULL, previous);
 	st.saveResolutionTables(filename + "ResTables");
 	st.save_gens(filename + "gens_data");
 	
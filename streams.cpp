@@ -24,6 +24,12 @@ std::ios::streampos con_streams::write(std::function<void(std::iostream&)> write
 	return pos;
 }
 
+//flush the written data
+void con_streams::fflush(){
+	std::lock_guard<std::mutex> lk(locker);
+	steam->flush();
+}
+
 //constructor
 con_fstreams::con_fstreams(string fname) : con_streams(&file), file(fname, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc){
 	filename = fname;
@@ -39,6 +39,9 @@ public:
 	
 	//write and return the position
 	std::ios::streampos write(std::function<void(std::iostream&)> writer);
+	
+	//flush the written data
+	void fflush();
 };
 
 //file streams